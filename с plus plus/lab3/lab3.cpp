@@ -2,6 +2,117 @@
 #include <string>
 #include <cstdlib>
 #include <ctime>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <cstdint>
+#include <string_view>
+#include <climits>
+#include <cerrno>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#define NOMINMAX // Иначе макросы min/max из windows.h ломают std::min и std::max
+#include <windows.h>
+#else
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Быстрый генератор случайных латинских букв.
+ * Четыре независимые дорожки xoshiro256** шагают одновременно (цикл по дорожкам
+ * векторизуется компилятором), один шаг дает 256 бит - 16 символов по 16 бит.
+ * 16-битное значение переводится в [0, 52) умножением со сдвигом, смещение
+ * распределения не превышает 1/1260 (против rand() % 52 с общим состоянием).
+ */
+class LetterGenerator {
+private:
+    static const int LANES = 4;
+    uint64_t state[4][LANES];   // state[k][lane] - k-е слово состояния дорожки lane
+
+    static uint64_t splitMix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // Один шаг всех дорожек: 4 случайных 64-битных числа
+    void next(uint64_t out[LANES]) {
+        for (int lane = 0; lane < LANES; ++lane) {
+            out[lane] = rotl(state[1][lane] * 5, 7) * 9;
+            uint64_t t = state[1][lane] << 17;
+            state[2][lane] ^= state[0][lane];
+            state[3][lane] ^= state[1][lane];
+            state[1][lane] ^= state[2][lane];
+            state[0][lane] ^= state[3][lane];
+            state[2][lane] ^= t;
+            state[3][lane] = rotl(state[3][lane], 45);
+        }
+    }
+
+public:
+    static const int CHARS_PER_STEP = LANES * 4;  // Символов за один шаг генератора
+
+    /*
+     * Создает генератор.
+     * @param seed - зерно, общее для всех потоков.
+     * @param stream - номер независимого потока (например, номер блока данных).
+     */
+    LetterGenerator(uint64_t seed, uint64_t stream) {
+        uint64_t mixer = stream;
+        uint64_t x = seed ^ splitMix64(mixer);
+        for (int lane = 0; lane < LANES; ++lane) {
+            for (int k = 0; k < 4; ++k) {
+                state[k][lane] = splitMix64(x);
+            }
+        }
+    }
+
+    /*
+     * Заполняет буфер случайными буквами [A-Za-z].
+     * @param out - буфер для заполнения.
+     * @param n - количество символов.
+     */
+    void fill(char* out, size_t n) {
+        uint64_t words[LANES];
+        uint16_t bits[CHARS_PER_STEP];
+        char block[CHARS_PER_STEP];
+
+        size_t i = 0;
+        while (i < n) {
+            next(words);
+            std::memcpy(bits, words, sizeof(bits));
+            // Полные шаги пишутся прямо в буфер, хвост - через временный блок
+            char* target = (n - i >= CHARS_PER_STEP) ? out + i : block;
+            for (int k = 0; k < CHARS_PER_STEP; ++k) {
+                uint32_t index = (static_cast<uint32_t>(bits[k]) * 52) >> 16;
+                // Буквы 'a'..'z' идут в ASCII на 6 позиций позже, чем 'A' + 26
+                target[k] = static_cast<char>('A' + index + (index >= 26 ? 6 : 0));
+            }
+            size_t count = std::min<size_t>(CHARS_PER_STEP, n - i);
+            if (target == block) {
+                std::memcpy(out + i, block, count);
+            }
+            i += count;
+        }
+    }
+};
 
 struct String {
     int length;          // Длина строки
@@ -10,6 +121,15 @@ struct String {
     // Конструктор для инициализации структуры
     String() : length(0), characters(nullptr) {}
 
+    // Строка владеет буфером, поэтому копирование запрещено, а перемещение передает буфер
+    String(const String&) = delete;
+    String& operator=(const String&) = delete;
+
+    String(String&& other) : length(other.length), characters(other.characters) {
+        other.length = 0;
+        other.characters = nullptr;
+    }
+
     /* 
      * Метод для создания строки заданной длины.
      * Генерирует случайную строку из английских букв (заглавные и маленькие).
@@ -31,12 +151,35 @@ struct String {
         characters[length] = '\0'; // Завершающий символ
     }
 
+    /* 
+     * Создает строку заданной длины с помощью быстрого генератора.
+     * @param len - длина создаваемой строки.
+     * @param generator - генератор букв, принадлежащий вызывающему потоку.
+     */
+    void generateString(int len, LetterGenerator& generator) {
+        delete[] characters;
+        length = len;
+        characters = new char[length + 1]; // +1 для символа конца строки
+        generator.fill(characters, static_cast<size_t>(length));
+        characters[length] = '\0'; // Завершающий символ
+    }
+
     // Деструктор для освобождения памяти
     ~String() {
         delete[] characters;
     }
 };
 
+/*
+ * Представление строки без владения символами (например, строки отображенного файла).
+ * Поля совпадают по именам со структурой String, поэтому все функции-запросы,
+ * параметризованные типом строки, принимают оба типа.
+ */
+struct StringView {
+    int length;                 // Длина строки
+    const char* characters;     // Указатель на символы (без завершающего нуля)
+};
+
 /* 
  * Подсчитывает количество повторений определенного символа в массиве строк.
  * @param strings - массив строк.
@@ -44,8 +187,9 @@ struct String {
  * @param c - символ для подсчета.
  * @return Количество повторений символа.
  */
-int countCharacterOccurrences(String* strings, int N, char c) {
-    int count = 0;
+template <typename S>
+long long countCharacterOccurrences(S* strings, int N, char c) {
+    long long count = 0;
     for (int i = 0; i < N; ++i) {
         for (int j = 0; j < strings[i].length; ++j) {
             if (strings[i].characters[j] == c) {
@@ -62,7 +206,8 @@ int countCharacterOccurrences(String* strings, int N, char c) {
  * @param N - количество строк в массиве.
  * @return Максимально длинная повторяющаяся последовательность.
  */
-std::string findLongestRepeatingSequence(String* strings, int N) {
+template <typename S>
+std::string findLongestRepeatingSequence(S* strings, int N) {
     std::string longest;
 
     for (int i = 0; i < N; ++i) {
@@ -91,31 +236,201 @@ std::string findLongestRepeatingSequence(String* strings, int N) {
     return longest;
 }
 
-/* 
- * Складывает все строки массива в одну итоговую строку.
- * @param strings - массив строк.
- * @param N - количество строк в массиве.
- * @return Итоговая строка.
+/*
+ * Фрагмент веревки: ссылка на чужие символы без копирования.
  */
-String concatenateStrings(String* strings, int N) {
-    String result;
-    result.length = 0;
+struct RopeSegment {
+    const char* data;
+    size_t length;
+};
 
-    for (int i = 0; i < N; ++i) {
-        result.length += strings[i].length;
+/*
+ * Веревка (rope) - результат объединения строк в виде списка фрагментов.
+ * Фрагменты ссылаются на исходные строки, поэтому веревка действительна,
+ * пока живы строки, из которых она собрана. Символы выводятся прямо
+ * из исходных строк; плоский буфер создается только по запросу методом materialize.
+ */
+class ThreadPool;
+
+class StringRope {
+private:
+    std::vector<RopeSegment> segments;  // Фрагменты в порядке следования
+    size_t totalLength;                 // Суммарная длина всех фрагментов
+
+public:
+    StringRope() : totalLength(0) {}
+
+    /*
+     * Добавляет фрагмент в конец веревки. Пустые фрагменты пропускаются.
+     * @param data - указатель на символы фрагмента.
+     * @param length - длина фрагмента.
+     */
+    void append(const char* data, size_t length) {
+        if (length == 0) {
+            return;
+        }
+        segments.push_back({data, length});
+        totalLength += length;
     }
 
-    result.characters = new char[result.length + 1]; // +1 для завершающего символа
-    int index = 0;
+    size_t length() const {
+        return totalLength;
+    }
 
-    for (int i = 0; i < N; ++i) {
-        for (int j = 0; j < strings[i].length; ++j) {
-            result.characters[index++] = strings[i].characters[j];
+    size_t segmentCount() const {
+        return segments.size();
+    }
+
+    const RopeSegment& segment(size_t index) const {
+        return segments[index];
+    }
+
+    /*
+     * Итератор для посимвольного потокового обхода веревки.
+     */
+    class Iterator {
+    private:
+        const StringRope* rope;  // Обходимая веревка
+        size_t segmentIndex;     // Номер текущего фрагмента
+        size_t offset;           // Смещение внутри фрагмента
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char*;
+        using reference = const char&;
+
+        Iterator(const StringRope* r, size_t index) : rope(r), segmentIndex(index), offset(0) {}
+
+        const char& operator*() const {
+            return rope->segments[segmentIndex].data[offset];
+        }
+
+        Iterator& operator++() {
+            if (++offset == rope->segments[segmentIndex].length) {
+                ++segmentIndex;
+                offset = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return segmentIndex == other.segmentIndex && offset == other.offset;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
         }
+    };
+
+    Iterator begin() const {
+        return Iterator(this, 0);
     }
 
-    result.characters[result.length] = '\0'; // Завершающий символ
-    return result;
+    Iterator end() const {
+        return Iterator(this, segments.size());
+    }
+
+    /*
+     * Записывает веревку в файловый дескриптор пачками фрагментов (writev).
+     * @param fd - файловый дескриптор.
+     * @return true, если все данные записаны.
+     */
+    bool writeToDescriptor(int fd) const {
+#ifdef _WIN32
+        for (const auto& seg : segments) {
+            size_t written = 0;
+            while (written < seg.length) {
+                unsigned part = static_cast<unsigned>(std::min<size_t>(seg.length - written, 1u << 30));
+                int result = _write(fd, seg.data + written, part);
+                if (result <= 0) {
+                    return false;
+                }
+                written += static_cast<size_t>(result);
+            }
+        }
+        return true;
+#else
+        const size_t batchSize = 1024; // Не превышает IOV_MAX на распространенных системах
+        std::vector<iovec> batch;
+        batch.reserve(batchSize);
+
+        for (size_t first = 0; first < segments.size(); first += batchSize) {
+            size_t last = std::min(segments.size(), first + batchSize);
+            batch.clear();
+            for (size_t i = first; i < last; ++i) {
+                batch.push_back({const_cast<char*>(segments[i].data), segments[i].length});
+            }
+
+            // writev может записать только часть данных - досылаем остаток
+            size_t current = 0;
+            while (current < batch.size()) {
+                ssize_t written = writev(fd, batch.data() + current, static_cast<int>(batch.size() - current));
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue; // Прервано сигналом до записи - повторяем
+                    }
+                    return false;
+                }
+                size_t remaining = static_cast<size_t>(written);
+                while (current < batch.size() && remaining >= batch[current].iov_len) {
+                    remaining -= batch[current].iov_len;
+                    ++current;
+                }
+                if (current < batch.size()) {
+                    batch[current].iov_base = static_cast<char*>(batch[current].iov_base) + remaining;
+                    batch[current].iov_len -= remaining;
+                }
+            }
+        }
+        return true;
+#endif
+    }
+
+    /*
+     * Создает плоскую копию веревки. Единственное место, где веревка копируется
+     * в общий буфер, - вызывать только там, где нужна непрерывная строка.
+     * @param pool - пул потоков для параллельного копирования (nullptr - в текущем потоке).
+     * @return Строка со всеми символами веревки.
+     * @throws std::length_error - если веревка длиннее INT_MAX байт (длина String - int).
+     */
+    String materialize(ThreadPool* pool = nullptr) const;
+};
+
+/*
+ * Дескриптор стандартного вывода для записи веревки в обход буфера std::cout.
+ */
+#ifdef _WIN32
+const int STANDARD_OUTPUT = 1;
+#else
+const int STANDARD_OUTPUT = STDOUT_FILENO;
+#endif
+
+/* 
+ * Складывает все строки массива в веревку без копирования символов.
+ * @param strings - массив строк.
+ * @param N - количество строк в массиве.
+ * @return Веревка, ссылающаяся на строки массива.
+ */
+template <typename S>
+StringRope concatenateStringsRope(S* strings, int N) {
+    StringRope rope;
+    for (int i = 0; i < N; ++i) {
+        rope.append(strings[i].characters, static_cast<size_t>(strings[i].length));
+    }
+    return rope;
+}
+
+/* 
+ * Складывает все строки массива в одну итоговую строку.
+ * @param strings - массив строк.
+ * @param N - количество строк в массиве.
+ * @return Итоговая строка.
+ */
+template <typename S>
+String concatenateStrings(S* strings, int N) {
+    return concatenateStringsRope(strings, N).materialize();
 }
 
 /* 
@@ -125,14 +440,15 @@ String concatenateStrings(String* strings, int N) {
  * @param substring - подстрока для подсчета вхождений.
  * @return Количество вхождений подстроки.
  */
-int countSubstringOccurrences(String* strings, int N, const std::string& substring) {
-    int count = 0;
+template <typename S>
+long long countSubstringOccurrences(S* strings, int N, const std::string& substring) {
+    long long count = 0;
 
     for (int i = 0; i < N; ++i) {
-        std::string currentString(strings[i].characters);
+        std::string_view currentString(strings[i].characters, strings[i].length);
         size_t pos = currentString.find(substring);
 
-        while (pos != std::string::npos) {
+        while (pos != std::string_view::npos) {
             count++;
             pos = currentString.find(substring, pos + 1);
         }
@@ -141,29 +457,497 @@ int countSubstringOccurrences(String* strings, int N, const std::string& substri
     return count;
 }
 
-int main() {
-    srand(static_cast<unsigned int>(time(0))); // Инициализация генератора случайных чисел
+/*
+ * Пул потоков фиксированного размера.
+ * Рабочие потоки создаются один раз и переиспользуются всеми запросами.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;      // Рабочие потоки
+    std::mutex mutex;                      // Защита состояния задания
+    std::condition_variable wakeWorkers;   // Сигнал о новом задании
+    std::condition_variable jobDone;       // Сигнал о завершении задания
+    std::function<void(int)> job;          // Текущее задание (принимает номер подзадачи)
+    int taskCount;                         // Количество подзадач в задании
+    int nextTask;                          // Номер следующей невыданной подзадачи
+    int finishedTasks;                     // Количество завершенных подзадач
+    long long generation;                  // Номер текущего задания
+    bool stopping;                         // Флаг завершения работы пула
 
-    int N;
-    std::cout << "Введите число N: ";
-    std::cin >> N;
+    void workerLoop() {
+        long long seenGeneration = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeWorkers.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
 
-    // Массив строк типа "Строка"
-    String* customStrings = new String[N];
+            while (nextTask < taskCount) {
+                int task = nextTask++;
+                lock.unlock();
+                job(task);
+                lock.lock();
+                if (++finishedTasks == taskCount) {
+                    jobDone.notify_all();
+                }
+            }
+        }
+    }
 
-    // Массив строк типа "std::string"
-    std::string* stdStrings = new std::string[N];
+public:
+    /*
+     * Создает пул потоков.
+     * @param threads - количество потоков (0 - по числу ядер процессора).
+     */
+    explicit ThreadPool(unsigned threads = 0)
+        : taskCount(0), nextTask(0), finishedTasks(0), generation(0), stopping(false) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
 
-    // Генерация строк и заполнение массивов
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeWorkers.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    int size() const {
+        return static_cast<int>(workers.size());
+    }
+
+    /*
+     * Выполняет подзадачи 0..count-1 на потоках пула и ждет их завершения.
+     * @param count - количество подзадач.
+     * @param task - функция, принимающая номер подзадачи.
+     */
+    void run(int count, const std::function<void(int)>& task) {
+        if (count <= 0) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        job = task;
+        taskCount = count;
+        nextTask = 0;
+        finishedTasks = 0;
+        ++generation;
+        wakeWorkers.notify_all();
+        jobDone.wait(lock, [&] { return finishedTasks == taskCount; });
+        job = nullptr;
+    }
+};
+
+/*
+ * Размер блока строк параллельной генерации. Каждый блок получает собственный
+ * поток генератора по своему номеру, поэтому результат зависит только от зерна,
+ * но не от числа потоков.
+ */
+const int GENERATION_BLOCK_STRINGS = 4096;
+
+/*
+ * Параллельно создает массив случайных строк быстрым генератором.
+ * @param strings - массив строк.
+ * @param N - количество строк в массиве.
+ * @param len - длина каждой строки.
+ * @param seed - зерно генератора.
+ * @param pool - пул потоков.
+ */
+void generateStringsParallel(String* strings, int N, int len, uint64_t seed, ThreadPool& pool) {
+    int blocks = (N + GENERATION_BLOCK_STRINGS - 1) / GENERATION_BLOCK_STRINGS;
+    pool.run(blocks, [&](int b) {
+        LetterGenerator generator(seed, static_cast<uint64_t>(b));
+        int end = std::min(N, (b + 1) * GENERATION_BLOCK_STRINGS);
+        for (int i = b * GENERATION_BLOCK_STRINGS; i < end; ++i) {
+            strings[i].generateString(len, generator);
+        }
+    });
+}
+
+/*
+ * Диапазон строк [begin, end), обрабатываемый одной подзадачей.
+ */
+struct StringChunk {
+    int begin;
+    int end;
+};
+
+/*
+ * Делит массив строк на части с примерно равной суммарной длиной в байтах.
+ * @param strings - массив строк.
+ * @param N - количество строк в массиве.
+ * @param chunkCount - желаемое количество частей.
+ * @return Непустые диапазоны строк в порядке следования.
+ */
+template <typename S>
+std::vector<StringChunk> splitByLength(S* strings, int N, int chunkCount) {
+    std::vector<StringChunk> chunks;
+    if (N <= 0) {
+        return chunks;
+    }
+
+    long long totalBytes = 0;
     for (int i = 0; i < N; ++i) {
-        customStrings[i].generateString(50);
-        stdStrings[i] = std::string(customStrings[i].characters); // Копирование в std::string
+        totalBytes += strings[i].length;
+    }
+    chunkCount = std::max(1, std::min(chunkCount, N));
 
-        // Вывод строк
-        std::cout << "Строка " << (i + 1) << " (структура): " << customStrings[i].characters << std::endl;
-        std::cout << "Строка " << (i + 1) << " (std::string): " << stdStrings[i] << std::endl;
+    // Граница k-й части - первая строка, на которой накопленная длина достигает k/chunkCount от общей
+    int begin = 0;
+    long long accumulated = 0;
+    for (int i = 0; i < N; ++i) {
+        accumulated += strings[i].length;
+        long long target = totalBytes * (static_cast<long long>(chunks.size()) + 1) / chunkCount;
+        if (accumulated >= target && static_cast<int>(chunks.size()) < chunkCount - 1) {
+            chunks.push_back({begin, i + 1});
+            begin = i + 1;
+        }
+    }
+    if (begin < N) {
+        chunks.push_back({begin, N});
+    }
+    return chunks;
+}
+
+/*
+ * Количество частей на один поток: небольшой запас сглаживает неравномерность нагрузки.
+ */
+const int CHUNKS_PER_THREAD = 4;
+
+/* 
+ * Параллельный подсчет повторений символа.
+ * Каждая часть считает свой результат, суммирование выполняется по порядку частей.
+ * @param strings - массив строк.
+ * @param N - количество строк в массиве.
+ * @param c - символ для подсчета.
+ * @param pool - пул потоков.
+ * @return Количество повторений символа.
+ */
+template <typename S>
+long long countCharacterOccurrencesParallel(S* strings, int N, char c, ThreadPool& pool) {
+    std::vector<StringChunk> chunks = splitByLength(strings, N, pool.size() * CHUNKS_PER_THREAD);
+    std::vector<long long> partial(chunks.size(), 0);
+
+    pool.run(static_cast<int>(chunks.size()), [&](int k) {
+        long long count = 0;
+        for (int i = chunks[k].begin; i < chunks[k].end; ++i) {
+            const char* data = strings[i].characters;
+            count += std::count(data, data + strings[i].length, c);
+        }
+        partial[k] = count;
+    });
+
+    long long total = 0;
+    for (long long value : partial) {
+        total += value;
+    }
+    return total;
+}
+
+/* 
+ * Параллельный поиск максимально длинной повторяющейся последовательности.
+ * Части сворачиваются слева направо тем же правилом, что и в последовательной версии
+ * (побеждает первая строго более длинная), поэтому результат совпадает с ней.
+ * @param strings - массив строк.
+ * @param N - количество строк в массиве.
+ * @param pool - пул потоков.
+ * @return Максимально длинная повторяющаяся последовательность.
+ */
+template <typename S>
+std::string findLongestRepeatingSequenceParallel(S* strings, int N, ThreadPool& pool) {
+    std::vector<StringChunk> chunks = splitByLength(strings, N, pool.size() * CHUNKS_PER_THREAD);
+    std::vector<std::string> partial(chunks.size());
+
+    pool.run(static_cast<int>(chunks.size()), [&](int k) {
+        partial[k] = findLongestRepeatingSequence(strings + chunks[k].begin, chunks[k].end - chunks[k].begin);
+    });
+
+    std::string longest;
+    for (const auto& value : partial) {
+        if (value.length() > longest.length()) {
+            longest = value;
+        }
+    }
+    return longest;
+}
+
+/*
+ * Смещения фрагментов в итоговом буфере вычисляются префиксной суммой длин,
+ * после чего каждая часть копирует свои фрагменты сразу на итоговые позиции.
+ */
+String StringRope::materialize(ThreadPool* pool) const {
+    if (totalLength > static_cast<size_t>(INT_MAX)) {
+        throw std::length_error("Веревка длиннее " + std::to_string(INT_MAX) + " байт");
+    }
+    int count = static_cast<int>(segments.size());
+    std::vector<size_t> offsets(segments.size() + 1, 0);
+    for (int i = 0; i < count; ++i) {
+        offsets[i + 1] = offsets[i] + segments[i].length;
+    }
+
+    String result;
+    result.length = static_cast<int>(totalLength);
+    result.characters = new char[totalLength + 1]; // +1 для завершающего символа
+
+    auto copyChunk = [&](const StringChunk& chunk) {
+        for (int i = chunk.begin; i < chunk.end; ++i) {
+            std::memcpy(result.characters + offsets[i], segments[i].data, segments[i].length);
+        }
+    };
+    if (pool) {
+        std::vector<StringChunk> chunks = splitByLength(segments.data(), count, pool->size() * CHUNKS_PER_THREAD);
+        pool->run(static_cast<int>(chunks.size()), [&](int k) { copyChunk(chunks[k]); });
+    } else {
+        copyChunk({0, count});
+    }
+
+    result.characters[totalLength] = '\0'; // Завершающий символ
+    return result;
+}
+
+/* 
+ * Параллельный подсчет вхождений подстроки.
+ * Вхождения не пересекают границы строк, поэтому части независимы.
+ * @param strings - массив строк.
+ * @param N - количество строк в массиве.
+ * @param substring - подстрока для подсчета вхождений.
+ * @param pool - пул потоков.
+ * @return Количество вхождений подстроки.
+ */
+template <typename S>
+long long countSubstringOccurrencesParallel(S* strings, int N, const std::string& substring, ThreadPool& pool) {
+    std::vector<StringChunk> chunks = splitByLength(strings, N, pool.size() * CHUNKS_PER_THREAD);
+    std::vector<long long> partial(chunks.size(), 0);
+
+    pool.run(static_cast<int>(chunks.size()), [&](int k) {
+        partial[k] = countSubstringOccurrences(strings + chunks[k].begin, chunks[k].end - chunks[k].begin, substring);
+    });
+
+    long long total = 0;
+    for (long long value : partial) {
+        total += value;
+    }
+    return total;
+}
+
+/*
+ * Файл, отображенный в память только для чтения.
+ */
+class MappedFile {
+private:
+    const char* data;   // Начало отображения
+    size_t size;        // Размер файла в байтах
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+
+public:
+    MappedFile() : data(nullptr), size(0) {
+#ifdef _WIN32
+        fileHandle = INVALID_HANDLE_VALUE;
+        mappingHandle = nullptr;
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    /*
+     * Отображает файл в память.
+     * @param path - путь к файлу.
+     * @return true, если файл успешно отображен.
+     */
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            close();
+            return false;
+        }
+        size = static_cast<size_t>(fileSize.QuadPart);
+        if (size == 0) {
+            return true; // Пустой файл отображать не нужно
+        }
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr) {
+            close();
+            return false;
+        }
+        data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (data == nullptr) {
+            close();
+            return false;
+        }
+        return true;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(info.st_size);
+        if (size == 0) {
+            ::close(fd);
+            return true; // Пустой файл отображать не нужно
+        }
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // Отображение остается действительным и после закрытия дескриптора
+        if (mapping == MAP_FAILED) {
+            size = 0;
+            return false;
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapping);
+        return true;
+#endif
     }
 
+    void close() {
+#ifdef _WIN32
+        if (data != nullptr) {
+            UnmapViewOfFile(data);
+        }
+        if (mappingHandle != nullptr) {
+            CloseHandle(mappingHandle);
+            mappingHandle = nullptr;
+        }
+        if (fileHandle != INVALID_HANDLE_VALUE) {
+            CloseHandle(fileHandle);
+            fileHandle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    const char* begin() const {
+        return data;
+    }
+
+    size_t length() const {
+        return size;
+    }
+};
+
+/*
+ * Файлы меньше этого размера индексируются в одном потоке.
+ */
+const size_t PARALLEL_INDEX_MIN_BYTES = 1 << 22;
+
+/*
+ * Строит индекс строк текста, разделенных символом '\n'.
+ * Переводы строк ищутся memchr (векторизованным в стандартной библиотеке),
+ * большие файлы делятся на диапазоны байт и сканируются на потоках пула.
+ * Завершающий '\r' отбрасывается, последняя строка без '\n' тоже учитывается.
+ * @param text - начало текста.
+ * @param size - размер текста в байтах.
+ * @param pool - пул потоков.
+ * @return Представления строк, ссылающиеся на текст без копирования.
+ * @throws std::length_error - если строка длиннее INT_MAX байт (длина StringView - int).
+ */
+std::vector<StringView> buildLineIndex(const char* text, size_t size, ThreadPool& pool) {
+    int rangeCount = size < PARALLEL_INDEX_MIN_BYTES ? 1 : pool.size() * CHUNKS_PER_THREAD;
+    size_t rangeBytes = (size + rangeCount - 1) / std::max(1, rangeCount);
+
+    // Этап 1: позиции переводов строк в каждом диапазоне
+    std::vector<std::vector<size_t>> newlines(rangeCount);
+    pool.run(rangeCount, [&](int r) {
+        size_t pos = std::min(size, static_cast<size_t>(r) * rangeBytes);
+        size_t end = std::min(size, pos + rangeBytes);
+        while (pos < end) {
+            const void* found = std::memchr(text + pos, '\n', end - pos);
+            if (found == nullptr) {
+                break;
+            }
+            size_t index = static_cast<size_t>(static_cast<const char*>(found) - text);
+            newlines[r].push_back(index);
+            pos = index + 1;
+        }
+    });
+
+    // Этап 2: номер первой строки каждого диапазона и начало этой строки
+    std::vector<size_t> firstLine(rangeCount + 1, 0);
+    std::vector<size_t> lineStart(rangeCount, 0);
+    size_t start = 0;
+    for (int r = 0; r < rangeCount; ++r) {
+        firstLine[r + 1] = firstLine[r] + newlines[r].size();
+        lineStart[r] = start;
+        if (!newlines[r].empty()) {
+            start = newlines[r].back() + 1;
+        }
+    }
+    bool hasTail = start < size;
+
+    // Этап 3: каждый диапазон записывает свои строки сразу на итоговые позиции
+    std::vector<StringView> lines(firstLine[rangeCount] + (hasTail ? 1 : 0));
+    std::atomic<bool> overlong(false);
+    auto makeLine = [text, &overlong](size_t from, size_t to) {
+        if (to > from && text[to - 1] == '\r') {
+            --to;
+        }
+        if (to - from > static_cast<size_t>(INT_MAX)) {
+            overlong.store(true, std::memory_order_relaxed);
+            return StringView{0, text + from};
+        }
+        return StringView{static_cast<int>(to - from), text + from};
+    };
+    pool.run(rangeCount, [&](int r) {
+        size_t from = lineStart[r];
+        for (size_t k = 0; k < newlines[r].size(); ++k) {
+            lines[firstLine[r] + k] = makeLine(from, newlines[r][k]);
+            from = newlines[r][k] + 1;
+        }
+    });
+    if (hasTail) {
+        lines.back() = makeLine(start, size);
+    }
+    if (overlong.load()) {
+        throw std::length_error("Строка файла длиннее " + std::to_string(INT_MAX) + " байт");
+    }
+    return lines;
+}
+
+/*
+ * Меню запросов над массивом строк.
+ * @param strings - массив строк (String или StringView).
+ * @param N - количество строк в массиве.
+ * @param pool - пул потоков для параллельного режима.
+ */
+template <typename S>
+void runQueries(S* strings, int N, ThreadPool& pool) {
+    bool parallelMode = false;
+
     // Меню для выбора действий
     int choice;
     do {
@@ -173,6 +957,7 @@ int main() {
         std::cout << "3. Объединить все строки в одну\n";
         std::cout << "4. Подсчитать вхождения подстроки\n";
         std::cout << "5. Выход\n";
+        std::cout << "6. Параллельный режим (" << (parallelMode ? "включен" : "выключен") << ")\n";
         std::cout << "Ваш выбор: ";
         std::cin >> choice;
 
@@ -181,37 +966,131 @@ int main() {
                 char c;
                 std::cout << "Введите символ: ";
                 std::cin >> c;
-                int occurrences = countCharacterOccurrences(customStrings, N, c);
+                long long occurrences = parallelMode
+                    ? countCharacterOccurrencesParallel(strings, N, c, pool)
+                    : countCharacterOccurrences(strings, N, c);
                 std::cout << "Количество повторений символа '" << c << "': " << occurrences << std::endl;
                 break;
             }
             case 2: {
-                std::string longest = findLongestRepeatingSequence(customStrings, N);
+                std::string longest = parallelMode
+                    ? findLongestRepeatingSequenceParallel(strings, N, pool)
+                    : findLongestRepeatingSequence(strings, N);
                 std::cout << "Максимально длинная повторяющаяся последовательность: " << longest << std::endl;
                 break;
             }
             case 3: {
-                String result = concatenateStrings(customStrings, N);
-                std::cout << "Объединенная строка: " << result.characters << std::endl;
-                delete[] result.characters; // Освобождение памяти
+                // Веревка выводится по фрагментам, без копирования строк в общий буфер
+                StringRope rope = concatenateStringsRope(strings, N);
+                std::cout << "Объединенная строка: " << std::flush;
+                if (!rope.writeToDescriptor(STANDARD_OUTPUT)) {
+                    std::cout << "\nОшибка записи объединенной строки.";
+                }
+                std::cout << std::endl;
                 break;
             }
             case 4: {
                 std::string substring;
                 std::cout << "Введите подстроку: ";
                 std::cin >> substring;
-                int count = countSubstringOccurrences(customStrings, N, substring);
+                long long count = parallelMode
+                    ? countSubstringOccurrencesParallel(strings, N, substring, pool)
+                    : countSubstringOccurrences(strings, N, substring);
                 std::cout << "Количество вхождений подстроки '" << substring << "': " << count << std::endl;
                 break;
             }
             case 5:
                 std::cout << "Выход из программы." << std::endl;
                 break;
+            case 6:
+                parallelMode = !parallelMode;
+                std::cout << "Параллельный режим " << (parallelMode ? "включен" : "выключен")
+                          << " (потоков: " << pool.size() << ")." << std::endl;
+                break;
             default:
                 std::cout << "Неверный выбор. Попробуйте снова." << std::endl;
                 break;
         }
     } while (choice != 5);
+}
+
+/*
+ * Параметры командной строки:
+ *   --seed <число> - быстрая воспроизводимая генерация строк с заданным зерном;
+ *   --fast         - быстрая генерация со случайным зерном;
+ *   --file <путь>  - запросы к строкам текстового файла вместо сгенерированных.
+ */
+int main(int argc, char* argv[]) {
+    srand(static_cast<unsigned int>(time(0))); // Инициализация генератора случайных чисел
+
+    bool fastGeneration = false;
+    uint64_t seed = static_cast<uint64_t>(time(0));
+    std::string filePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            fastGeneration = true;
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--fast") {
+            fastGeneration = true;
+        } else if (arg == "--file" && i + 1 < argc) {
+            filePath = argv[++i];
+        }
+    }
+
+    // Пул потоков для генерации и параллельного режима выполнения запросов
+    ThreadPool pool;
+
+    if (!filePath.empty()) {
+        // Строки файла не копируются: запросы работают с представлениями отображенного текста
+        MappedFile file;
+        if (!file.open(filePath)) {
+            std::cout << "Не удалось открыть файл: " << filePath << std::endl;
+            return 1;
+        }
+        std::vector<StringView> lines;
+        try {
+            lines = buildLineIndex(file.begin(), file.length(), pool);
+        } catch (const std::length_error& e) {
+            std::cout << e.what() << std::endl;
+            return 1;
+        }
+        if (lines.size() > static_cast<size_t>(INT_MAX)) {
+            std::cout << "Слишком много строк в файле: " << lines.size() << std::endl;
+            return 1;
+        }
+        std::cout << "Загружено строк: " << lines.size() << " (" << file.length() << " байт)" << std::endl;
+        runQueries(lines.data(), static_cast<int>(lines.size()), pool);
+        return 0;
+    }
+
+    int N;
+    std::cout << "Введите число N: ";
+    std::cin >> N;
+
+    // Массив строк типа "Строка"
+    String* customStrings = new String[N];
+
+    // Массив строк типа "std::string"
+    std::string* stdStrings = new std::string[N];
+
+    if (fastGeneration) {
+        generateStringsParallel(customStrings, N, 50, seed, pool);
+    }
+
+    // Генерация строк и заполнение массивов
+    for (int i = 0; i < N; ++i) {
+        if (!fastGeneration) {
+            customStrings[i].generateString(50);
+        }
+        stdStrings[i] = std::string(customStrings[i].characters); // Копирование в std::string
+
+        // Вывод строк
+        std::cout << "Строка " << (i + 1) << " (структура): " << customStrings[i].characters << std::endl;
+        std::cout << "Строка " << (i + 1) << " (std::string): " << stdStrings[i] << std::endl;
+    }
+
+    runQueries(customStrings, N, pool);
 
     // Освобождение выделенной памяти
     delete[] customStrings;
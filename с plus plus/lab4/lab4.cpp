@@ -1,7 +1,18 @@
 #include <iostream>
 #include <vector>
+#include <variant>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
+#include <climits>
+#include <algorithm>
+#include <numeric>
+#include <map>
+#include <queue>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <stdexcept>
 
 // Перечисление для типов персонажей
 enum CharacterType {
@@ -10,15 +21,8 @@ enum CharacterType {
     ARCHER
 };
 
-// Базовый класс Персонаж
-class Character {
-public:
-    virtual ~Character() {}
-    virtual void display() const = 0;
-};
-
 // Класс Мечник
-class Swordsman : public Character {
+class Swordsman {
 public:
     int strength;
     int endurance;
@@ -28,14 +32,14 @@ public:
     Swordsman(int str, int endur, int dist, int cst)
         : strength(str), endurance(endur), distance(dist), cost(cst) {}
 
-    void display() const override {
+    void display() const {
         std::cout << "Swordsman - Strength: " << strength << ", Endurance: " << endurance
                   << ", Distance: " << distance << ", Cost: " << cost << std::endl;
     }
 };
 
 // Класс Маг
-class Mage : public Character {
+class Mage {
 public:
     int strength;
     int endurance;
@@ -45,14 +49,14 @@ public:
     Mage(int str, int endur, int dist, int cst)
         : strength(str), endurance(endur), distance(dist), cost(cst) {}
 
-    void display() const override {
+    void display() const {
         std::cout << "Mage - Strength: " << strength << ", Endurance: " << endurance
                   << ", Distance: " << distance << ", Cost: " << cost << std::endl;
     }
 };
 
 // Класс Стрелок
-class Archer : public Character {
+class Archer {
 public:
     int strength;
     int endurance;
@@ -62,123 +66,807 @@ public:
     Archer(int str, int endur, int dist, int cst)
         : strength(str), endurance(endur), distance(dist), cost(cst) {}
 
-    void display() const override {
+    void display() const {
         std::cout << "Archer - Strength: " << strength << ", Endurance: " << endurance
                   << ", Distance: " << distance << ", Cost: " << cost << std::endl;
     }
 };
 
-// Класс Наемник
-class Mercenary {
+// Наемник - значение одного из типов персонажей, без выделения памяти в куче.
+// Альтернативы variant идут в порядке CharacterType, поэтому index() совпадает с типом.
+using Mercenary = std::variant<Swordsman, Mage, Archer>;
+
+// Возвращает тип персонажа наемника
+inline CharacterType typeOf(const Mercenary& mercenary) {
+    return static_cast<CharacterType>(mercenary.index());
+}
+
+// Параметры подбора отряда
+struct SquadQuery {
+    int budget = 0;                     // Максимальная суммарная стоимость отряда
+    int strengthWeight = 1;             // Вес силы в оценке отряда
+    int enduranceWeight = 1;            // Вес стойкости в оценке отряда
+    int minDistance = 0;                // Минимальная дистанция наемника
+    int maxDistance = INT_MAX;          // Максимальная дистанция наемника
+    int maxUnits = 0;                   // Наибольший размер отряда (0 - без ограничения)
+    int minPerType[3] = {0, 0, 0};      // Минимальное число наемников каждого типа (роли)
+    long long nodeLimit = 5000000;      // Предел узлов перебора с отсечениями
+};
+
+// Результат подбора отряда
+struct Squad {
+    std::vector<size_t> members;        // Индексы наемников в гильдии
+    long long totalCost = 0;
+    long long totalStrength = 0;
+    long long totalEndurance = 0;
+    long long score = 0;                // Взвешенная оценка отряда
+    bool feasible = false;              // Найден ли отряд, удовлетворяющий ограничениям
+    bool optimal = false;               // Доказана ли оптимальность (перебор не прерван)
+};
+
+// Параметры выборки наемников (границы включительно)
+struct GuildQuery {
+    int typeMask = 7;                   // Битовая маска типов: 1 << CharacterType
+    int minDistance = INT_MIN;
+    int maxDistance = INT_MAX;
+    int minCost = INT_MIN;
+    int maxCost = INT_MAX;
+    size_t limit = SIZE_MAX;            // Сколько сильнейших вернуть (top-k)
+};
+
+// Класс Гильдия
+// Характеристики наемников хранятся по столбцам (struct-of-arrays): каждый столбец -
+// непрерывный массив, а тип персонажа - отдельный столбец-метка. Проходы по одной
+// характеристике читают только нужные данные, а наемник не требует своей памяти в куче.
+class Guild {
 private:
-    void* character;        // Указатель на пустоту для хранения персонажа
-    CharacterType type;     // Переменная для хранения типа персонажа
+    std::vector<uint8_t> types;     // Столбец типов (CharacterType)
+    std::vector<int> strength;      // Столбец силы
+    std::vector<int> endurance;     // Столбец стойкости
+    std::vector<int> distance;      // Столбец дистанции
+    std::vector<int> cost;          // Столбец стоимости
+
+    // Вторичный индекс одной группы (тип, дистанция): наемники упорядочены по стоимости,
+    // над ними построено дерево отрезков с позицией наибольшей силы
+    struct CostIndex {
+        std::vector<uint32_t> ids;      // Индексы наемников по возрастанию (стоимость, индекс)
+        std::vector<int> costs;         // Стоимости в том же порядке - для двоичного поиска
+        std::vector<uint32_t> tree;     // Дерево отрезков: позиция максимума силы
+        std::vector<uint32_t> pending;  // Добавленные, но еще не влитые в индекс
+    };
+
+    // Индексы по типу персонажа, внутри - по дистанции. Изменяются при чтении,
+    // поэтому запросы к одной гильдии нельзя выполнять из нескольких потоков сразу.
+    mutable std::map<int, CostIndex> indexes[3];
+    mutable bool indexesStale = false;  // Индексы нужно собрать заново (после загрузки снимка)
+
+    // Заголовок двоичного снимка гильдии; за ним подряд идут столбцы
+    // types (count байт), strength, endurance, distance, cost (по count чисел int32)
+    struct SnapshotHeader {
+        char magic[4];          // "GLD1"
+        uint32_t version;       // Версия формата
+        uint32_t byteOrder;     // 0x01020304 в порядке байт записавшей машины
+        uint32_t reserved;
+        uint64_t count;         // Количество наемников
+    };
+    static_assert(sizeof(int) == 4, "Snapshot columns are stored as 32-bit integers");
+    static const uint32_t SNAPSHOT_VERSION = 1;
+    static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
 
 public:
-    Mercenary() : character(nullptr), type(SWORDSMAN) {}
+    // Количество наемников в гильдии
+    size_t size() const {
+        return types.size();
+    }
 
-    // Метод для установки персонажа и его типа
-    void setCharacter(void* charPtr, CharacterType charType) {
-        character = charPtr;
-        type = charType;
+    // Резервирует место под заданное количество наемников
+    void reserve(size_t count) {
+        types.reserve(count);
+        strength.reserve(count);
+        endurance.reserve(count);
+        distance.reserve(count);
+        cost.reserve(count);
     }
 
-    // Метод для отображения информации о наемнике
-    void display() const {
-        switch (type) {
-            case SWORDSMAN:
-                static_cast<Swordsman*>(character)->display();
-                break;
-            case MAGE:
-                static_cast<Mage*>(character)->display();
-                break;
-            case ARCHER:
-                static_cast<Archer*>(character)->display();
-                break;
-            default:
-                std::cout << "Unknown character type!" << std::endl;
-                break;
+    // Метод для добавления наемника по характеристикам
+    void addMercenary(CharacterType type, int str, int endur, int dist, int cst) {
+        types.push_back(static_cast<uint8_t>(type));
+        strength.push_back(str);
+        endurance.push_back(endur);
+        distance.push_back(dist);
+        cost.push_back(cst);
+        if (!indexesStale) {
+            indexes[type][dist].pending.push_back(static_cast<uint32_t>(types.size() - 1));
         }
     }
 
-    // Деструктор, который очищает память для персонажа
-    ~Mercenary() {
-        switch (type) {
-            case SWORDSMAN:
-                delete static_cast<Swordsman*>(character);
-                break;
+    // Метод для добавления наемника в гильдию
+    void addMercenary(const Mercenary& mercenary) {
+        std::visit([&](const auto& unit) {
+            addMercenary(typeOf(mercenary), unit.strength, unit.endurance, unit.distance, unit.cost);
+        }, mercenary);
+    }
+
+    /*
+     * Пакетное добавление наемников: столбцы расширяются один раз,
+     * затем заполняются подряд.
+     * @param count - количество добавляемых наемников.
+     * @param generator - функция (индекс) -> Mercenary.
+     */
+    template <typename Generator>
+    void addMercenaries(size_t count, Generator generator) {
+        reserve(size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            addMercenary(generator(i));
+        }
+    }
+
+    // Тип наемника по индексу
+    CharacterType typeAt(size_t index) const {
+        return static_cast<CharacterType>(types[index]);
+    }
+
+    int strengthAt(size_t index) const { return strength[index]; }
+    int enduranceAt(size_t index) const { return endurance[index]; }
+    int distanceAt(size_t index) const { return distance[index]; }
+    int costAt(size_t index) const { return cost[index]; }
+
+    // Собирает значение наемника из столбцов
+    Mercenary at(size_t index) const {
+        switch (typeAt(index)) {
             case MAGE:
-                delete static_cast<Mage*>(character);
-                break;
+                return Mage(strength[index], endurance[index], distance[index], cost[index]);
             case ARCHER:
-                delete static_cast<Archer*>(character);
-                break;
+                return Archer(strength[index], endurance[index], distance[index], cost[index]);
+            case SWORDSMAN:
+            default:
+                return Swordsman(strength[index], endurance[index], distance[index], cost[index]);
         }
     }
-};
 
-// Класс Гильдия
-class Guild {
-private:
-    std::vector<Mercenary> mercenaries;  // Список наемников в гильдии
-
-public:
-    // Метод для добавления наемника в гильдию
-    void addMercenary(const Mercenary& mercenary) {
-        mercenaries.push_back(mercenary);
+    /*
+     * Статическая диспетчеризация по метке типа: функция вызывается
+     * с конкретным типом персонажа, без виртуальных вызовов.
+     * @param index - индекс наемника.
+     * @param visitor - функция, принимающая Swordsman, Mage или Archer.
+     */
+    template <typename Visitor>
+    decltype(auto) visit(size_t index, Visitor&& visitor) const {
+        return std::visit(std::forward<Visitor>(visitor), at(index));
     }
 
     // Метод для отображения всех наемников в гильдии
     void display() const {
         std::cout << "Guild contains the following mercenaries:\n";
-        for (const auto& merc : mercenaries) {
-            merc.display();
+        for (size_t i = 0; i < size(); ++i) {
+            visit(i, [](const auto& unit) { unit.display(); });
         }
     }
 
     // Метод для случайного заполнения гильдии
-    void fillRandomly() {
+    void fillRandomly(size_t extraCount = 0) {
         srand(time(0));
 
         // Обязательные наемники
-        Swordsman* tank = new Swordsman(80, 200, 1, 700);  // Мечник-танк с высокой стойкостью
-        Swordsman* highDamage = new Swordsman(150, 100, 1, 600);  // Мечник с высокой атакой
+        addMercenary(Swordsman(80, 200, 1, 700));   // Мечник-танк с высокой стойкостью
+        addMercenary(Swordsman(150, 100, 1, 600));  // Мечник с высокой атакой
+        addMercenary(Mage(130, 90, 3, 500));        // Маг средней дистанции
+        addMercenary(Mage(120, 80, 4, 550));        // Маг дальней дистанции
+        addMercenary(Archer(100, 160, 2, 450));     // Стрелок средней дистанции
+        addMercenary(Archer(90, 180, 3, 480));      // Стрелок дальней дистанции
+
+        // Дополнительные случайные наемники
+        addMercenaries(extraCount, [](size_t) -> Mercenary {
+            int str = 60 + rand() % 100;
+            int endur = 60 + rand() % 150;
+            int cst = 300 + rand() % 500;
+            switch (rand() % 3) {
+                case 0:
+                    return Swordsman(str, endur, 1, cst);
+                case 1:
+                    return Mage(str, endur, 2 + rand() % 3, cst);
+                default:
+                    return Archer(str, endur, 2 + rand() % 2, cst);
+            }
+        });
+    }
+
+    /*
+     * Подбирает отряд с наибольшей взвешенной оценкой силы и стойкости
+     * в пределах бюджета.
+     *
+     * Сначала отбрасываются наемники, которых всегда можно заменить не менее сильным
+     * и не более дорогим наемником вне отряда (см. squadCandidates). Затем:
+     *  - без ролевых ограничений и ограничения размера решается рюкзак 0/1
+     *    динамическим программированием по бюджету (стоимости делятся на их НОД,
+     *    строка обновляется векторизуемым проходом по двум буферам);
+     *  - иначе выполняется перебор с отсечениями по дробной оценке рюкзака.
+     * @param query - параметры подбора.
+     * @return Найденный отряд.
+     */
+    Squad selectSquad(const SquadQuery& query) const {
+        std::vector<SquadItem> items = squadCandidates(query);
+        bool constrained = query.maxUnits > 0 ||
+                           query.minPerType[0] > 0 || query.minPerType[1] > 0 || query.minPerType[2] > 0;
+        Squad squad = constrained ? solveBranchAndBound(items, query) : solveKnapsack(items, query);
+
+        for (size_t index : squad.members) {
+            squad.totalCost += cost[index];
+            squad.totalStrength += strength[index];
+            squad.totalEndurance += endurance[index];
+        }
+        squad.score = query.strengthWeight * squad.totalStrength + query.enduranceWeight * squad.totalEndurance;
+        std::sort(squad.members.begin(), squad.members.end());
+        return squad;
+    }
+
+    // Метод для отображения отряда
+    void displaySquad(const Squad& squad) const {
+        if (!squad.feasible) {
+            std::cout << "No squad satisfies the constraints." << std::endl;
+            return;
+        }
+        std::cout << "Squad of " << squad.members.size() << " mercenaries (cost " << squad.totalCost
+                  << ", strength " << squad.totalStrength << ", endurance " << squad.totalEndurance
+                  << (squad.optimal ? ", optimal" : ", best found") << "):\n";
+        displaySelection(squad.members);
+    }
+
+    /*
+     * Сохраняет гильдию в двоичный снимок: заголовок и столбцы целиком,
+     * без преобразования отдельных наемников.
+     * @param path - путь к файлу снимка.
+     * @throw std::runtime_error При ошибке записи.
+     */
+    void saveSnapshot(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot open snapshot for writing: " + path);
+        }
+        SnapshotHeader header = {};
+        std::memcpy(header.magic, "GLD1", 4);
+        header.version = SNAPSHOT_VERSION;
+        header.byteOrder = SNAPSHOT_BYTE_ORDER;
+        header.count = size();
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeColumn(out, types);
+        writeColumn(out, strength);
+        writeColumn(out, endurance);
+        writeColumn(out, distance);
+        writeColumn(out, cost);
+        if (!out) {
+            throw std::runtime_error("Failed to write snapshot: " + path);
+        }
+    }
+
+    /*
+     * Загружает гильдию из двоичного снимка, заменяя текущий состав.
+     * Каждый столбец читается одним вызовом во временный массив; состав
+     * заменяется, только когда весь снимок прочитан и проверен, поэтому
+     * при ошибке гильдия остается прежней. Индексы собираются при первом запросе.
+     * @param path - путь к файлу снимка.
+     * @throw std::runtime_error Если файл не читается, не является снимком гильдии
+     *                           или поврежден (длина не сходится, неизвестный тип).
+     */
+    void loadSnapshot(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Cannot open snapshot: " + path);
+        }
+        SnapshotHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in || std::memcmp(header.magic, "GLD1", 4) != 0) {
+            throw std::runtime_error("Not a guild snapshot: " + path);
+        }
+        if (header.version != SNAPSHOT_VERSION || header.byteOrder != SNAPSHOT_BYTE_ORDER) {
+            throw std::runtime_error("Unsupported snapshot version or byte order: " + path);
+        }
 
-        Mage* midRangeMage = new Mage(130, 90, 3, 500);  // Маг средней дистанции
-        Mage* longRangeMage = new Mage(120, 80, 4, 550); // Маг дальней дистанции
+        // Количество сверяется с длиной файла до выделения памяти под столбцы
+        std::streamoff dataStart = in.tellg();
+        in.seekg(0, std::ios::end);
+        uint64_t available = static_cast<uint64_t>(in.tellg() - dataStart);
+        in.seekg(dataStart);
+        const uint64_t recordSize = sizeof(uint8_t) + 4 * sizeof(int);
+        if (!in || header.count > available / recordSize) {
+            throw std::runtime_error("Snapshot is truncated: " + path);
+        }
 
-        Archer* midRangeArcher = new Archer(100, 160, 2, 450);  // Стрелок средней дистанции
-        Archer* longRangeArcher = new Archer(90, 180, 3, 480);  // Стрелок дальней дистанции
+        size_t count = static_cast<size_t>(header.count);
+        std::vector<uint8_t> newTypes;
+        std::vector<int> newStrength, newEndurance, newDistance, newCost;
+        readColumn(in, newTypes, count);
+        readColumn(in, newStrength, count);
+        readColumn(in, newEndurance, count);
+        readColumn(in, newDistance, count);
+        readColumn(in, newCost, count);
+        if (!in) {
+            throw std::runtime_error("Snapshot is truncated: " + path);
+        }
+        for (uint8_t type : newTypes) {
+            if (type > ARCHER) {
+                throw std::runtime_error("Snapshot has unknown mercenary type " + std::to_string(type) + ": " + path);
+            }
+        }
 
-        // Добавляем обязательных наемников
-        Mercenary merc1, merc2, merc3, merc4, merc5, merc6;
-        merc1.setCharacter(static_cast<void*>(tank), SWORDSMAN);
-        merc2.setCharacter(static_cast<void*>(highDamage), SWORDSMAN);
-        merc3.setCharacter(static_cast<void*>(midRangeMage), MAGE);
-        merc4.setCharacter(static_cast<void*>(longRangeMage), MAGE);
-        merc5.setCharacter(static_cast<void*>(midRangeArcher), ARCHER);
-        merc6.setCharacter(static_cast<void*>(longRangeArcher), ARCHER);
+        types.swap(newTypes);
+        strength.swap(newStrength);
+        endurance.swap(newEndurance);
+        distance.swap(newDistance);
+        cost.swap(newCost);
 
-        addMercenary(merc1);
-        addMercenary(merc2);
-        addMercenary(merc3);
-        addMercenary(merc4);
-        addMercenary(merc5);
-        addMercenary(merc6);
+        for (auto& byDistance : indexes) {
+            byDistance.clear();
+        }
+        indexesStale = true;
+    }
 
-        // Можно добавить еще случайных наемников, если нужно
+    // Метод для отображения выбранных наемников
+    void displaySelection(const std::vector<size_t>& selection) const {
+        for (size_t index : selection) {
+            visit(index, [](const auto& unit) { unit.display(); });
+        }
+    }
+
+    /*
+     * Выборка наемников по типам и диапазонам дистанции и стоимости,
+     * упорядоченная по убыванию силы.
+     * Для каждой подходящей группы (тип, дистанция) диапазон стоимости находится
+     * двоичным поиском, а сильнейшие извлекаются через дерево отрезков и общую
+     * кучу отрезков: O((k + групп) * log n) для k результатов.
+     * Новые наемники вливаются в индекс при первом запросе после добавления.
+     * @param filter - параметры выборки.
+     * @return Индексы наемников по убыванию силы.
+     */
+    std::vector<size_t> query(const GuildQuery& filter) const {
+        // Кандидат в куче: сильнейший наемник отрезка [low, high) группы
+        struct Range {
+            int strength;
+            const CostIndex* index;
+            size_t low, high, best;
+            bool operator<(const Range& other) const {
+                if (strength != other.strength) return strength < other.strength;
+                return index->ids[best] > other.index->ids[other.best];
+            }
+        };
+        std::priority_queue<Range> heap;
+        rebuildStaleIndexes();
+        auto pushRange = [&](const CostIndex& index, size_t low, size_t high) {
+            if (low < high) {
+                size_t best = strongestIn(index, low, high);
+                heap.push({strength[index.ids[best]], &index, low, high, best});
+            }
+        };
+
+        for (int type = 0; type < 3; ++type) {
+            if (!(filter.typeMask & (1 << type))) {
+                continue;
+            }
+            auto first = indexes[type].lower_bound(filter.minDistance);
+            auto last = indexes[type].upper_bound(filter.maxDistance);
+            for (auto it = first; it != last; ++it) {
+                CostIndex& index = it->second;
+                mergePending(index);
+                size_t low = std::lower_bound(index.costs.begin(), index.costs.end(), filter.minCost) - index.costs.begin();
+                size_t high = std::upper_bound(index.costs.begin(), index.costs.end(), filter.maxCost) - index.costs.begin();
+                pushRange(index, low, high);
+            }
+        }
+
+        std::vector<size_t> result;
+        while (!heap.empty() && result.size() < filter.limit) {
+            Range top = heap.top();
+            heap.pop();
+            result.push_back(top.index->ids[top.best]);
+            pushRange(*top.index, top.low, top.best);
+            pushRange(*top.index, top.best + 1, top.high);
+        }
+        return result;
+    }
+
+private:
+    template <typename T>
+    static void writeColumn(std::ofstream& out, const std::vector<T>& column) {
+        out.write(reinterpret_cast<const char*>(column.data()),
+                  static_cast<std::streamsize>(column.size() * sizeof(T)));
+    }
+
+    template <typename T>
+    static void readColumn(std::ifstream& in, std::vector<T>& column, size_t count) {
+        column.resize(count);
+        in.read(reinterpret_cast<char*>(column.data()), static_cast<std::streamsize>(count * sizeof(T)));
+    }
+
+    // Распределяет всех наемников по группам индексов после загрузки снимка
+    void rebuildStaleIndexes() const {
+        if (!indexesStale) {
+            return;
+        }
+        for (size_t i = 0; i < size(); ++i) {
+            indexes[types[i]][distance[i]].pending.push_back(static_cast<uint32_t>(i));
+        }
+        indexesStale = false;
+    }
+
+    // Вливает отложенные добавления в индекс группы и перестраивает дерево отрезков
+    void mergePending(CostIndex& index) const {
+        if (index.pending.empty()) {
+            return;
+        }
+        auto byCost = [this](uint32_t a, uint32_t b) {
+            return cost[a] != cost[b] ? cost[a] < cost[b] : a < b;
+        };
+        std::sort(index.pending.begin(), index.pending.end(), byCost);
+        size_t oldSize = index.ids.size();
+        index.ids.insert(index.ids.end(), index.pending.begin(), index.pending.end());
+        std::inplace_merge(index.ids.begin(), index.ids.begin() + oldSize, index.ids.end(), byCost);
+        index.pending.clear();
+        index.pending.shrink_to_fit();
+
+        size_t n = index.ids.size();
+        index.costs.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            index.costs[i] = cost[index.ids[i]];
+        }
+
+        // Листья дерева - позиции n..2n-1, внутренний узел хранит позицию более сильного сына
+        index.tree.assign(2 * n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            index.tree[n + i] = static_cast<uint32_t>(i);
+        }
+        for (size_t node = n; node-- > 1;) {
+            index.tree[node] = stronger(index, index.tree[2 * node], index.tree[2 * node + 1]);
+        }
+    }
+
+    // Позиция более сильного из двух наемников индекса (при равенстве - левая)
+    uint32_t stronger(const CostIndex& index, uint32_t a, uint32_t b) const {
+        if (strength[index.ids[b]] > strength[index.ids[a]] ||
+            (strength[index.ids[b]] == strength[index.ids[a]] && b < a)) {
+            return b;
+        }
+        return a;
+    }
+
+    // Позиция сильнейшего наемника на отрезке [low, high) индекса
+    size_t strongestIn(const CostIndex& index, size_t low, size_t high) const {
+        size_t n = index.ids.size();
+        uint32_t best = static_cast<uint32_t>(low);
+        for (low += n, high += n; low < high; low >>= 1, high >>= 1) {
+            if (low & 1) best = stronger(index, best, index.tree[low++]);
+            if (high & 1) best = stronger(index, best, index.tree[--high]);
+        }
+        return best;
+    }
+
+    // Кандидат в отряд
+    struct SquadItem {
+        size_t index;       // Индекс наемника в гильдии
+        int type;           // Тип персонажа
+        long long cost;     // Стоимость (не меньше 0)
+        long long value;    // Взвешенная оценка
+    };
+
+    // Отбор кандидатов по запросу с отбрасыванием заведомо лишних наемников
+    std::vector<SquadItem> squadCandidates(const SquadQuery& query) const {
+        std::vector<SquadItem> items;
+        for (size_t i = 0; i < size(); ++i) {
+            if (distance[i] < query.minDistance || distance[i] > query.maxDistance || cost[i] > query.budget) {
+                continue;
+            }
+            long long value = static_cast<long long>(query.strengthWeight) * strength[i] +
+                              static_cast<long long>(query.enduranceWeight) * endurance[i];
+            items.push_back({i, types[i], std::max(0, cost[i]), value});
+        }
+
+        // Наемник i лишний, если более ранние в порядке (оценка по убыванию, стоимость
+        // по возрастанию) наемники D того же класса не хуже его по обоим параметрам и
+        // все вместе с i не помещаются в отряд: тогда в любом отряде с i найдется
+        // не вошедший в него j из D, и замена i на j не ухудшает отряд.
+        // Без ролевых ограничений класс один, с ролями - отдельный для каждого типа.
+        bool byType = query.minPerType[0] > 0 || query.minPerType[1] > 0 || query.minPerType[2] > 0;
+        std::sort(items.begin(), items.end(), [](const SquadItem& a, const SquadItem& b) {
+            if (a.value != b.value) return a.value > b.value;
+            if (a.cost != b.cost) return a.cost < b.cost;
+            return a.index < b.index;
+        });
+
+        std::vector<long long> costs;
+        for (const auto& item : items) {
+            costs.push_back(item.cost);
+        }
+        std::sort(costs.begin(), costs.end());
+        costs.erase(std::unique(costs.begin(), costs.end()), costs.end());
+
+        // Деревья Фенвика по стоимости: сумма стоимостей и число уже просмотренных наемников
+        size_t width = costs.size();
+        std::vector<long long> costSum(3 * (width + 1), 0);
+        std::vector<long long> unitCount(3 * (width + 1), 0);
+
+        std::vector<SquadItem> kept;
+        for (const auto& item : items) {
+            size_t base = byType ? item.type * (width + 1) : 0;
+            size_t position = std::lower_bound(costs.begin(), costs.end(), item.cost) - costs.begin() + 1;
+
+            long long cheaperCost = 0, cheaperCount = 0;
+            for (size_t k = position; k > 0; k -= k & (~k + 1)) {
+                cheaperCost += costSum[base + k];
+                cheaperCount += unitCount[base + k];
+            }
+            bool dominated = cheaperCost > query.budget - item.cost ||
+                             (query.maxUnits > 0 && cheaperCount >= query.maxUnits);
+            if (!dominated) {
+                kept.push_back(item);
+            }
+
+            for (size_t k = position; k <= width; k += k & (~k + 1)) {
+                costSum[base + k] += item.cost;
+                unitCount[base + k] += 1;
+            }
+        }
+        return kept;
+    }
+
+    // Рюкзак 0/1 динамическим программированием по бюджету
+    Squad solveKnapsack(std::vector<SquadItem> items, const SquadQuery& query) const {
+        Squad squad;
+        squad.feasible = query.budget >= 0;
+        squad.optimal = true;
+
+        // Наемники с неположительной оценкой не улучшают отряд
+        items.erase(std::remove_if(items.begin(), items.end(),
+                                   [](const SquadItem& item) { return item.value <= 0; }),
+                    items.end());
+        if (items.empty() || !squad.feasible) {
+            return squad;
+        }
+
+        long long step = 0;
+        for (const auto& item : items) {
+            step = std::gcd(step, item.cost);
+        }
+        step = std::max(1LL, step);
+        size_t width = static_cast<size_t>(query.budget / step) + 1;
+        size_t words = (width + 63) / 64;
+
+        // best[b] - наибольшая оценка при стоимости не больше b * step
+        std::vector<long long> best(width, 0);
+        std::vector<long long> next(width, 0);
+        std::vector<uint8_t> takenRow(width, 0);
+        std::vector<uint64_t> taken(items.size() * words, 0);
+
+        for (size_t k = 0; k < items.size(); ++k) {
+            size_t shift = static_cast<size_t>(items[k].cost / step);
+            long long value = items[k].value;
+            const long long* prev = best.data();
+            long long* cur = next.data();
+            uint8_t* flags = takenRow.data();
+
+            for (size_t b = 0; b < shift; ++b) {
+                cur[b] = prev[b];
+                flags[b] = 0;
+            }
+            // Проход без зависимостей между итерациями - компилятор векторизует его
+            for (size_t b = shift; b < width; ++b) {
+                long long candidate = prev[b - shift] + value;
+                bool take = candidate > prev[b];
+                cur[b] = take ? candidate : prev[b];
+                flags[b] = take;
+            }
+
+            uint64_t* bits = taken.data() + k * words;
+            for (size_t b = shift; b < width; ++b) {
+                bits[b >> 6] |= static_cast<uint64_t>(flags[b]) << (b & 63);
+            }
+            best.swap(next);
+        }
+
+        // Восстановление состава с конца
+        size_t b = width - 1;
+        for (size_t k = items.size(); k-- > 0;) {
+            if ((taken[k * words + (b >> 6)] >> (b & 63)) & 1) {
+                squad.members.push_back(items[k].index);
+                b -= static_cast<size_t>(items[k].cost / step);
+            }
+        }
+        return squad;
+    }
+
+    // Перебор с отсечениями для запросов с ролями и ограничением размера отряда
+    Squad solveBranchAndBound(std::vector<SquadItem> items, const SquadQuery& query) const {
+        size_t n = items.size();
+        int maxUnits = query.maxUnits > 0 ? query.maxUnits : INT_MAX;
+
+        // Верхняя оценка с множителем Лагранжа penalty для ограничения размера отряда:
+        // сумма оценок не больше penalty * (число мест) + дробный рюкзак по оценкам
+        // value - penalty. Порядок перебора - по убыванию (value - penalty) / cost.
+        std::vector<long long> prefixCost(n + 1, 0), prefixValue(n + 1, 0);
+        long long penalty = 0;
+        auto arrange = [&](long long lambda) {
+            penalty = lambda;
+            // Бесплатные бойцы сравнением с перекрестным умножением не упорядочить (0 * x == 0
+            // для всех), поэтому они идут отдельно: с выгодой value - lambda > 0 - в начало,
+            // остальные - в конец
+            auto group = [lambda](const SquadItem& item) {
+                if (item.cost > 0) return 1;
+                return item.value - lambda > 0 ? 0 : 2;
+            };
+            std::sort(items.begin(), items.end(), [lambda, &group](const SquadItem& a, const SquadItem& b) {
+                int groupA = group(a), groupB = group(b);
+                if (groupA != groupB) return groupA < groupB;
+                if (groupA != 1) return a.index < b.index;
+                long double left = static_cast<long double>(a.value - lambda) * b.cost;
+                long double right = static_cast<long double>(b.value - lambda) * a.cost;
+                if (left != right) return left > right;
+                return a.index < b.index;
+            });
+            for (size_t i = 0; i < n; ++i) {
+                prefixCost[i + 1] = prefixCost[i] + items[i].cost;
+                prefixValue[i + 1] = prefixValue[i] + std::max(0LL, items[i].value - lambda);
+            }
+        };
+        auto upperBound = [&](size_t from, long long budgetLeft, long long unitsLeft) {
+            size_t last = std::upper_bound(prefixCost.begin() + from, prefixCost.end(),
+                                           prefixCost[from] + budgetLeft) - prefixCost.begin() - 1;
+            long long bound = prefixValue[last] - prefixValue[from];
+            if (last < n && items[last].cost > 0) {
+                long long rest = budgetLeft - (prefixCost[last] - prefixCost[from]);
+                bound += std::max(0LL, items[last].value - penalty) * rest / items[last].cost;
+            }
+            return bound + penalty * unitsLeft;
+        };
+
+        // Оценка выпукла по множителю - подбираем его тернарным поиском на корне
+        arrange(0);
+        if (query.maxUnits > 0 && n > 0) {
+            long long low = 0, high = 0;
+            for (const auto& item : items) {
+                high = std::max(high, item.value);
+            }
+            while (high - low > 2) {
+                long long m1 = low + (high - low) / 3;
+                long long m2 = high - (high - low) / 3;
+                arrange(m1);
+                long long bound1 = upperBound(0, query.budget, maxUnits);
+                arrange(m2);
+                long long bound2 = upperBound(0, query.budget, maxUnits);
+                if (bound1 <= bound2) {
+                    high = m2;
+                } else {
+                    low = m1;
+                }
+            }
+            arrange(low);
+        }
+
+        // Суффиксные данные для проверки достижимости ролей
+        std::vector<int> suffixCount(3 * (n + 1), 0);
+        std::vector<long long> suffixMinCost(3 * (n + 1), LLONG_MAX);
+        for (size_t i = n; i-- > 0;) {
+            for (int t = 0; t < 3; ++t) {
+                suffixCount[3 * i + t] = suffixCount[3 * (i + 1) + t] + (items[i].type == t);
+                suffixMinCost[3 * i + t] = suffixMinCost[3 * (i + 1) + t];
+            }
+            suffixMinCost[3 * i + items[i].type] = std::min(suffixMinCost[3 * i + items[i].type], items[i].cost);
+        }
+
+        std::vector<size_t> chosen, bestChosen;
+        int counts[3] = {0, 0, 0};
+        long long bestValue = LLONG_MIN;
+        long long nodes = 0;
+        bool interrupted = false;
+
+        // Можно ли еще набрать недостающие роли из позиций начиная с from
+        auto rolesReachable = [&](size_t from, long long budgetLeft, int unitsLeft) {
+            long long needCost = 0;
+            int needUnits = 0;
+            for (int t = 0; t < 3; ++t) {
+                int need = std::max(0, query.minPerType[t] - counts[t]);
+                if (need == 0) continue;
+                if (suffixCount[3 * from + t] < need) return false;
+                needUnits += need;
+                needCost += need * suffixMinCost[3 * from + t];
+            }
+            return needUnits <= unitsLeft && needCost <= budgetLeft;
+        };
+
+        // Ветвление "какой наемник будет следующим в отряде": глубина равна размеру отряда
+        auto search = [&](auto& self, size_t from, long long budgetLeft, long long value) -> void {
+            if (++nodes > query.nodeLimit) {
+                interrupted = true;
+                return;
+            }
+            if (value > bestValue && rolesReachable(n, 0, 0)) {
+                bestValue = value;
+                bestChosen = chosen;
+            }
+            if (static_cast<int>(chosen.size()) >= maxUnits) {
+                return;
+            }
+            for (size_t i = from; i < n && !interrupted; ++i) {
+                // Оценка не растет с ростом i, поэтому дальше можно не смотреть
+                long long unitsLeft = maxUnits == INT_MAX ? 0 : maxUnits - static_cast<long long>(chosen.size());
+                if (bestValue != LLONG_MIN && value + upperBound(i, budgetLeft, unitsLeft) <= bestValue) {
+                    break;
+                }
+                if (items[i].cost > budgetLeft) {
+                    continue;
+                }
+                chosen.push_back(items[i].index);
+                counts[items[i].type]++;
+                int slotsLeft = maxUnits == INT_MAX ? INT_MAX : maxUnits - static_cast<int>(chosen.size());
+                if (rolesReachable(i + 1, budgetLeft - items[i].cost, slotsLeft)) {
+                    self(self, i + 1, budgetLeft - items[i].cost, value + items[i].value);
+                }
+                counts[items[i].type]--;
+                chosen.pop_back();
+            }
+        };
+        if (rolesReachable(0, query.budget, maxUnits)) {
+            search(search, 0, query.budget, 0);
+        }
+
+        Squad squad;
+        squad.feasible = bestValue != LLONG_MIN;
+        squad.optimal = !interrupted;
+        squad.members = bestChosen;
+        return squad;
     }
 };
 
-int main() {
+/*
+ * Параметры командной строки:
+ *   --load <путь> - загрузить гильдию из снимка вместо случайного заполнения;
+ *   --save <путь> - сохранить гильдию в снимок.
+ */
+int main(int argc, char* argv[]) {
+    std::string loadPath, savePath;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--load") {
+            loadPath = argv[++i];
+        } else if (arg == "--save") {
+            savePath = argv[++i];
+        }
+    }
+
     // Создаем гильдию
     Guild guild;
 
-    // Заполняем гильдию случайными наемниками
-    guild.fillRandomly();
+    try {
+        if (loadPath.empty()) {
+            // Заполняем гильдию случайными наемниками
+            guild.fillRandomly();
+        } else {
+            guild.loadSnapshot(loadPath);
+        }
+        if (!savePath.empty()) {
+            guild.saveSnapshot(savePath);
+        }
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
 
     // Отображаем информацию о гильдии
     guild.display();
 
+    // Подбираем лучший отряд в пределах бюджета, по одному наемнику каждой роли
+    SquadQuery query;
+    query.budget = 1600;
+    query.minPerType[SWORDSMAN] = 1;
+    query.minPerType[MAGE] = 1;
+    query.minPerType[ARCHER] = 1;
+    guild.displaySquad(guild.selectSquad(query));
+
+    // Стрелки с дистанцией не меньше 3 и стоимостью не больше 500 - по убыванию силы
+    GuildQuery archers;
+    archers.typeMask = 1 << ARCHER;
+    archers.minDistance = 3;
+    archers.maxCost = 500;
+    std::cout << "Archers with distance >= 3 and cost <= 500:\n";
+    guild.displaySelection(guild.query(archers));
+
     return 0;
 }
@@ -3,9 +3,47 @@
 #include <vector>
 #include <memory>
 #include <string>
-#include <cstdlib> // Для rand()
 #include <ctime>   // Для time()
 #include <algorithm> // Для std::max
+#include <random>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <mutex>
+#include <condition_variable>
+
+// Виды запчастей (порядок совпадает с меню createPart)
+enum PartKind {
+    VAL,
+    ELEKTRODVIGATEL,
+    PANEL_UPRAVLENIYA,
+    REZHUSHAYA_GOLOVKA
+};
+
+constexpr int PART_KIND_COUNT = 4;
+
+inline const char* partKindName(PartKind kind) {
+    static const char* const names[] = {"Val", "Elektrodvigatel", "Panel Upravleniya", "Rezhushaya Golovka"};
+    return names[kind];
+}
+
+// Строка таблицы запчастей (общая для отдельной запчасти и столбцов станка)
+inline void printPartRow(std::ostream& os, const std::string& name, double replacementCost, double repairCost,
+                         double repairTime, double lifetime, double wearLevel) {
+    os << std::setw(20) << std::left << name
+       << std::setw(15) << replacementCost
+       << std::setw(15) << repairCost
+       << std::setw(15) << repairTime
+       << std::setw(15) << lifetime
+       << std::setw(10) << wearLevel << "%";
+}
 
 class Zapchast {
 protected:
@@ -21,27 +59,22 @@ public:
         : replacementCost(rCost), repairCost(repCost), repairTime(repTime), lifetime(life), wearLevel(0) {}
 
     virtual bool isBroken() const {
-        return wearLevel >= 100;
+        return wearLevel >= getBreakThreshold();
     }
 
-    virtual void usePart(double usageIntensity) {
-        wearLevel += usageIntensity;
-        if (wearLevel > 100) {
-            wearLevel = 100;
-        }
-    }
+    virtual double getWearMultiplier() const { return 1.0; } // Множитель износа за час
+    virtual double getBreakThreshold() const { return 100; } // Износ, с которого запчасть сломана
+    double getWearLevel() const { return wearLevel; }
 
     double getRepairCost() const { return repairCost; } // Геттер для repairCost
     double getRepairTime() const { return repairTime; } // Геттер для repairTime
-    virtual std::string getName() const = 0;
+    double getReplacementCost() const { return replacementCost; }
+    double getLifetime() const { return lifetime; }
+    virtual PartKind getKind() const = 0;
+    std::string getName() const { return partKindName(getKind()); }
 
     friend std::ostream& operator<<(std::ostream& os, const Zapchast& z) {
-        os << std::setw(20) << std::left << z.getName() 
-           << std::setw(15) << z.replacementCost
-           << std::setw(15) << z.repairCost
-           << std::setw(15) << z.repairTime
-           << std::setw(15) << z.lifetime
-           << std::setw(10) << z.wearLevel << "%";
+        printPartRow(os, z.getName(), z.replacementCost, z.repairCost, z.repairTime, z.lifetime, z.wearLevel);
         return os;
     }
 
@@ -54,19 +87,16 @@ public:
     Val(double rCost, double repCost, double repTime, double life)
         : Zapchast(rCost, repCost, repTime, life) {}
 
-    bool isBroken() const override {
-        return wearLevel >= 80;
+    double getWearMultiplier() const override {
+        return 1.5;
     }
 
-    void usePart(double usageIntensity) override {
-        wearLevel += usageIntensity * 1.5;
-        if (wearLevel > 100) {
-            wearLevel = 100;
-        }
+    double getBreakThreshold() const override {
+        return 80;
     }
 
-    std::string getName() const override {
-        return "Val";
+    PartKind getKind() const override {
+        return VAL;
     }
 };
 
@@ -75,19 +105,16 @@ public:
     Elektrodvigatel(double rCost, double repCost, double repTime, double life)
         : Zapchast(rCost, repCost, repTime, life) {}
 
-    bool isBroken() const override {
-        return wearLevel >= 90;
+    double getWearMultiplier() const override {
+        return 1.2;
     }
 
-    void usePart(double usageIntensity) override {
-        wearLevel += usageIntensity * 1.2;
-        if (wearLevel > 100) {
-            wearLevel = 100;
-        }
+    double getBreakThreshold() const override {
+        return 90;
     }
 
-    std::string getName() const override {
-        return "Elektrodvigatel";
+    PartKind getKind() const override {
+        return ELEKTRODVIGATEL;
     }
 };
 
@@ -96,19 +123,12 @@ public:
     PanelUpravleniya(double rCost, double repCost, double repTime, double life)
         : Zapchast(rCost, repCost, repTime, life) {}
 
-    bool isBroken() const override {
-        return wearLevel >= 95;
+    double getBreakThreshold() const override {
+        return 95;
     }
 
-    void usePart(double usageIntensity) override {
-        wearLevel += usageIntensity;
-        if (wearLevel > 100) {
-            wearLevel = 100;
-        }
-    }
-
-    std::string getName() const override {
-        return "Panel Upravleniya";
+    PartKind getKind() const override {
+        return PANEL_UPRAVLENIYA;
     }
 };
 
@@ -117,60 +137,704 @@ public:
     RezhushayaGolovka(double rCost, double repCost, double repTime, double life)
         : Zapchast(rCost, repCost, repTime, life) {}
 
-    bool isBroken() const override {
-        return wearLevel >= 70;
+    double getWearMultiplier() const override {
+        return 2;
+    }
+
+    double getBreakThreshold() const override {
+        return 70;
+    }
+
+    PartKind getKind() const override {
+        return REZHUSHAYA_GOLOVKA;
+    }
+};
+
+// Последовательная двоичная запись состояния (для контрольных точек)
+struct StateWriter {
+    std::string bytes;
+
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be stored");
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // Столбец: длина и элементы одним куском
+    template <typename T>
+    void putColumn(const std::vector<T>& column) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be stored");
+        put(static_cast<uint64_t>(column.size()));
+        bytes.append(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+    }
+};
+
+// Чтение состояния, записанного StateWriter
+class StateReader {
+public:
+    explicit StateReader(const std::string& bytes) : bytes(bytes), offset(0) {}
+
+    template <typename T>
+    T get() {
+        T value;
+        take(&value, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void getColumn(std::vector<T>& column) {
+        uint64_t count = get<uint64_t>();
+        if (count > (bytes.size() - offset) / sizeof(T)) {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        column.resize(static_cast<size_t>(count));
+        take(column.data(), column.size() * sizeof(T));
+    }
+
+private:
+    const std::string& bytes;
+    size_t offset;
+
+    void take(void* target, size_t size) {
+        if (size > bytes.size() - offset) {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        std::memcpy(target, bytes.data() + offset, size);
+        offset += size;
+    }
+};
+
+/*
+ * Фоновая запись контрольных точек. Симуляция только сериализует состояние
+ * в буфер и передает его писателю, а файл пишется в отдельном потоке: сначала
+ * во временный файл, затем переименованием поверх прежней точки, поэтому на
+ * диске всегда лежит целая контрольная точка. Если писатель не успевает,
+ * ожидающий буфер заменяется более свежим.
+ */
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string& path)
+        : path(path), hasPending(false), stopping(false), thread(&CheckpointWriter::run, this) {}
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    ~CheckpointWriter() {
+        try {
+            finish();
+        } catch (const std::runtime_error&) {
+            // Ошибку сообщает finish(); из деструктора ее не выбросить
+        }
+    }
+
+    void submit(std::string bytes) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.swap(bytes);
+            hasPending = true;
+        }
+        wake.notify_one();
+    }
+
+    // Дожидается записи последней переданной точки
+    // @throw std::runtime_error Если какую-то точку не удалось записать.
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (thread.joinable()) {
+            thread.join();
+        }
+        if (!error.empty()) {
+            std::string message;
+            message.swap(error);
+            throw std::runtime_error(message);
+        }
+    }
+
+    // Записывает файл через временный файл и переименование
+    static void writeFile(const std::string& path, const std::string& bytes) {
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Cannot open checkpoint for writing: " + temporary);
+            }
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            out.flush();
+            if (!out) {
+                throw std::runtime_error("Failed to write checkpoint: " + temporary);
+            }
+        }
+#ifdef _WIN32
+        std::remove(path.c_str()); // rename в Windows не заменяет существующий файл
+#endif
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            throw std::runtime_error("Cannot replace checkpoint: " + path);
+        }
+    }
+
+private:
+    std::string path;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::string pending;
+    bool hasPending;
+    bool stopping;
+    std::string error;      // Первая ошибка записи
+    std::thread thread;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this]() { return hasPending || stopping; });
+            if (!hasPending) {
+                return;
+            }
+            std::string bytes;
+            bytes.swap(pending);
+            hasPending = false;
+            lock.unlock();
+            std::string failure;
+            try {
+                writeFile(path, bytes);
+            } catch (const std::runtime_error& e) {
+                failure = e.what();
+            }
+            lock.lock();
+            if (!failure.empty() && error.empty()) {
+                error = failure;
+            }
+        }
+    }
+};
+
+/*
+ * Счетчиковый генератор случайных чисел Philox4x32-10.
+ * Случайный блок - это шифр от счетчика (шаг, поток, назначение) на ключе,
+ * выведенном из зерна и номера прогона. Блоки не зависят друг от друга,
+ * поэтому их можно получать пачками и в любом порядке: станок берет поток
+ * со своим номером и час работы как шаг, и результат не зависит ни от
+ * порядка обхода станков, ни от числа потоков.
+ */
+class CounterRng {
+public:
+    using Block = std::array<uint32_t, 4>;
+
+    // Назначение случайных чисел (четвертое слово счетчика) - у каждого свое пространство шагов
+    enum Purpose : uint32_t {
+        HOURLY_CHECK = 1,   // Почасовая проверка: шаг - час работы станка
+        EVENT_CHECK = 2,    // Проверка событийной модели: шаг - месяц и номер проверки
+        MONTH_INTENSITY = 3, // Интенсивность месяца: шаг - номер месяца
+        FAST_FORWARD = 4    // Биномиальные числа аналитической модели: шаги месяца подряд
+    };
+
+    static constexpr uint32_t WORKSHOP_STREAM = 0xFFFFFFFFu; // Поток общих для цеха величин
+
+    CounterRng(uint64_t seed = 0, uint32_t replication = 0) : seed(seed), replication(replication) {
+        uint64_t mixed = splitMix(seed ^ splitMix(replication + 0x632BE59BD9B4E019ULL));
+        key[0] = static_cast<uint32_t>(mixed);
+        key[1] = static_cast<uint32_t>(mixed >> 32);
+    }
+
+    uint64_t getSeed() const { return seed; }
+    uint32_t getReplication() const { return replication; }
+
+    // Состояние генератора - только зерно и номер прогона; счетчики ведет владелец
+    void saveState(StateWriter& out) const {
+        out.put(seed);
+        out.put(replication);
+    }
+
+    void loadState(StateReader& in) {
+        uint64_t savedSeed = in.get<uint64_t>();
+        *this = CounterRng(savedSeed, in.get<uint32_t>());
+    }
+
+    // Блок из четырех случайных слов для (поток, шаг, назначение)
+    Block block(uint32_t stream, uint64_t step, uint32_t purpose) const {
+        return philox({static_cast<uint32_t>(step), static_cast<uint32_t>(step >> 32), stream, purpose}, key);
+    }
+
+    // Блоки для шагов firstStep .. firstStep + count - 1 подряд
+    void fill(uint32_t stream, uint64_t firstStep, uint32_t purpose, size_t count, Block* out) const {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = block(stream, firstStep + i, purpose);
+        }
+    }
+
+    // Равномерное число в [0, 1) из двух слов (53 бита)
+    static double uniform(uint32_t high, uint32_t low) {
+        return ((static_cast<uint64_t>(high) << 21) ^ (low >> 11)) * 0x1.0p-53;
+    }
+
+    // Число от 0 до n - 1 (умножение со сдвигом вместо деления)
+    static uint32_t below(uint32_t word, uint32_t n) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(word) * n) >> 32);
+    }
+
+    // Граница для проверки "слово < граница" с вероятностью p
+    static uint64_t chanceLimit(double p) {
+        if (p <= 0) {
+            return 0;
+        }
+        return p >= 1 ? (1ULL << 32) : static_cast<uint64_t>(p * 4294967296.0);
+    }
+
+    /*
+     * Адаптер к требованиям UniformRandomBitGenerator для распределений <random>:
+     * выдает слова блоков (поток, шаг, назначение) подряд, начиная с шага firstStep.
+     */
+    class Stream {
+    public:
+        using result_type = uint32_t;
+
+        Stream(const CounterRng& rng, uint32_t stream, uint64_t firstStep, uint32_t purpose)
+            : rng(&rng), stream(stream), step(firstStep), purpose(purpose), used(4) {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+        result_type operator()() {
+            if (used == 4) {
+                current = rng->block(stream, step++, purpose);
+                used = 0;
+            }
+            return current[used++];
+        }
+
+    private:
+        const CounterRng* rng;
+        uint32_t stream;
+        uint64_t step;
+        uint32_t purpose;
+        Block current;
+        int used;
+    };
+
+    /*
+     * Биномиальное число успехов из trials испытаний с вероятностью chance.
+     * При малом среднем (типичный случай - десятки проверок за месяц) функция
+     * распределения обращается по одному равномерному числу за O(среднего)
+     * умножений, иначе используется std::binomial_distribution.
+     */
+    static int binomial(Stream& draws, int trials, double chance) {
+        if (trials <= 0 || chance <= 0) {
+            return 0;
+        }
+        if (chance >= 1) {
+            return trials;
+        }
+        bool flipped = chance > 0.5; // Считаем неудачи, если они реже успехов
+        double q = flipped ? 1 - chance : chance;
+        int successes = 0;
+        if (trials * q < 30) {
+            uint32_t high = draws();
+            double u = uniform(high, draws());
+            double odds = q / (1 - q);
+            double probability = std::pow(1 - q, trials); // P(X = 0)
+            while (u >= probability && successes < trials) {
+                u -= probability;
+                probability *= odds * (trials - successes) / (successes + 1);
+                ++successes;
+            }
+        } else {
+            successes = std::binomial_distribution<int>(trials, q)(draws);
+        }
+        return flipped ? trials - successes : successes;
+    }
+
+private:
+    uint64_t seed;
+    uint32_t replication;
+    std::array<uint32_t, 2> key;
+
+    static uint64_t splitMix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    static Block philox(Block counter, std::array<uint32_t, 2> k) {
+        for (int round = 0; round < 10; ++round) {
+            uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * counter[0];
+            uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * counter[2];
+            counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ k[0], static_cast<uint32_t>(product1),
+                       static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ k[1], static_cast<uint32_t>(product0)};
+            k[0] += 0x9E3779B9u;
+            k[1] += 0xBB67AE85u;
+        }
+        return counter;
+    }
+};
+
+// Потоковые среднее и дисперсия (алгоритм Уэлфорда), объединяемые по формуле Чана
+class RunningMoments {
+public:
+    void add(double value) {
+        ++n;
+        double delta = value - mean;
+        mean += delta / n;
+        m2 += delta * (value - mean);
+        minimum = n == 1 ? value : std::min(minimum, value);
+        maximum = n == 1 ? value : std::max(maximum, value);
     }
 
-    void usePart(double usageIntensity) override {
-        wearLevel += usageIntensity * 2;
-        if (wearLevel > 100) {
-            wearLevel = 100;
+    void merge(const RunningMoments& other) {
+        if (other.n == 0) {
+            return;
         }
+        if (n == 0) {
+            *this = other;
+            return;
+        }
+        uint64_t total = n + other.n;
+        double delta = other.mean - mean;
+        mean += delta * other.n / total;
+        m2 += other.m2 + delta * delta * (static_cast<double>(n) * other.n / total);
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+        n = total;
+    }
+
+    uint64_t count() const { return n; }
+    double getMean() const { return mean; }
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0; }
+    double getMin() const { return minimum; }
+    double getMax() const { return maximum; }
+
+    void saveState(StateWriter& out) const {
+        out.put(n);
+        out.put(mean);
+        out.put(m2);
+        out.put(minimum);
+        out.put(maximum);
     }
 
-    std::string getName() const override {
-        return "Rezhushaya Golovka";
+    void loadState(StateReader& in) {
+        n = in.get<uint64_t>();
+        mean = in.get<double>();
+        m2 = in.get<double>();
+        minimum = in.get<double>();
+        maximum = in.get<double>();
     }
+
+private:
+    uint64_t n = 0;
+    double mean = 0;
+    double m2 = 0;      // Сумма квадратов отклонений от среднего
+    double minimum = 0;
+    double maximum = 0;
 };
 
+/*
+ * Гистограмма с логарифмическими корзинами (как HDR-гистограмма): каждая
+ * октава [2^e, 2^(e+1)) делится на SUB_BUCKETS равных частей, поэтому
+ * относительная погрешность квантилей не больше 1/(2 * SUB_BUCKETS).
+ * Добавление - одно frexp и инкремент, объединение - сложение счетчиков,
+ * так что результат объединения не зависит от порядка.
+ * Значения меньше 2^MIN_EXPONENT (и отрицательные) попадают в нулевую корзину.
+ */
+class LogHistogram {
+public:
+    static constexpr int SUB_BUCKETS = 32;
+    static constexpr int MIN_EXPONENT = -16;
+
+    void add(double value) {
+        moments.add(value);
+        int exponent;
+        double mantissa = std::frexp(value, &exponent); // value = mantissa * 2^exponent, mantissa в [0.5, 1)
+        if (!(value > 0) || exponent <= MIN_EXPONENT) {
+            ++zeros;
+            return;
+        }
+        size_t index = static_cast<size_t>(exponent - MIN_EXPONENT - 1) * SUB_BUCKETS +
+                       static_cast<size_t>((mantissa * 2 - 1) * SUB_BUCKETS);
+        if (index >= buckets.size()) {
+            buckets.resize(index + 1, 0);
+        }
+        ++buckets[index];
+    }
+
+    void merge(const LogHistogram& other) {
+        moments.merge(other.moments);
+        zeros += other.zeros;
+        if (other.buckets.size() > buckets.size()) {
+            buckets.resize(other.buckets.size(), 0);
+        }
+        for (size_t i = 0; i < other.buckets.size(); ++i) {
+            buckets[i] += other.buckets[i];
+        }
+    }
+
+    uint64_t count() const { return moments.count(); }
+    const RunningMoments& getMoments() const { return moments; }
+
+    // Квантиль уровня q (0..1): середина корзины, в которую попадает ранг ceil(q * n)
+    double quantile(double q) const {
+        uint64_t n = count();
+        if (n == 0) {
+            return 0;
+        }
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * n)));
+        uint64_t seen = zeros;
+        if (seen >= rank) {
+            return std::max(0.0, moments.getMin());
+        }
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                int exponent = static_cast<int>(i / SUB_BUCKETS) + MIN_EXPONENT + 1;
+                double low = std::ldexp(0.5 + 0.5 * (i % SUB_BUCKETS) / SUB_BUCKETS, exponent);
+                double high = std::ldexp(0.5 + 0.5 * (i % SUB_BUCKETS + 1) / SUB_BUCKETS, exponent);
+                return std::min(std::max((low + high) / 2, moments.getMin()), moments.getMax());
+            }
+        }
+        return moments.getMax();
+    }
+
+    void saveState(StateWriter& out) const {
+        moments.saveState(out);
+        out.put(zeros);
+        out.putColumn(buckets);
+    }
+
+    void loadState(StateReader& in) {
+        moments.loadState(in);
+        zeros = in.get<uint64_t>();
+        in.getColumn(buckets);
+    }
+
+private:
+    RunningMoments moments; // Точные среднее, дисперсия, минимум и максимум
+    uint64_t zeros = 0;
+    std::vector<uint64_t> buckets;
+};
+
+// Итоги станка за месяц: копятся при каждой поломке, забираются в конце месяца
+struct MonthRecord {
+    double downtime = 0;
+    double repairCost = 0;
+    std::array<int, PART_KIND_COUNT> failures{}; // Поломки по видам запчастей
+};
+
+// Распределения показателей цеха; объединяются между прогонами
+struct WorkshopStats {
+    std::vector<LogHistogram> monthlyDowntime; // Простой станка за месяц, отдельно для каждого месяца года
+    LogHistogram monthlyRepairCost;            // Стоимость ремонта станка за месяц
+    std::array<uint64_t, PART_KIND_COUNT> failuresByKind{};
+
+    void record(int month, const MonthRecord& machineMonth) {
+        if (month >= static_cast<int>(monthlyDowntime.size())) {
+            monthlyDowntime.resize(month + 1);
+        }
+        monthlyDowntime[month].add(machineMonth.downtime);
+        monthlyRepairCost.add(machineMonth.repairCost);
+        for (int kind = 0; kind < PART_KIND_COUNT; ++kind) {
+            failuresByKind[kind] += machineMonth.failures[kind];
+        }
+    }
+
+    void merge(const WorkshopStats& other) {
+        if (other.monthlyDowntime.size() > monthlyDowntime.size()) {
+            monthlyDowntime.resize(other.monthlyDowntime.size());
+        }
+        for (size_t month = 0; month < other.monthlyDowntime.size(); ++month) {
+            monthlyDowntime[month].merge(other.monthlyDowntime[month]);
+        }
+        monthlyRepairCost.merge(other.monthlyRepairCost);
+        for (int kind = 0; kind < PART_KIND_COUNT; ++kind) {
+            failuresByKind[kind] += other.failuresByKind[kind];
+        }
+    }
+
+    void saveState(StateWriter& out) const {
+        out.put(static_cast<uint64_t>(monthlyDowntime.size()));
+        for (const auto& histogram : monthlyDowntime) {
+            histogram.saveState(out);
+        }
+        monthlyRepairCost.saveState(out);
+        out.put(failuresByKind);
+    }
+
+    void loadState(StateReader& in) {
+        monthlyDowntime.assign(static_cast<size_t>(in.get<uint64_t>()), LogHistogram());
+        for (auto& histogram : monthlyDowntime) {
+            histogram.loadState(in);
+        }
+        monthlyRepairCost.loadState(in);
+        failuresByKind = in.get<std::array<uint64_t, PART_KIND_COUNT>>();
+    }
+};
+
+void printWorkshopStats(const WorkshopStats& stats) {
+    std::cout << "Поломки по видам запчастей:" << std::endl;
+    for (int kind = 0; kind < PART_KIND_COUNT; ++kind) {
+        std::cout << "  " << partKindName(static_cast<PartKind>(kind)) << ": " << stats.failuresByKind[kind] << std::endl;
+    }
+    std::cout << "Простой станка за месяц (среднее, p50, p90, p99, максимум):" << std::endl;
+    for (size_t month = 0; month < stats.monthlyDowntime.size(); ++month) {
+        const LogHistogram& h = stats.monthlyDowntime[month];
+        std::cout << "  Месяц " << month + 1 << ": " << h.getMoments().getMean() << ", " << h.quantile(0.5) << ", "
+                  << h.quantile(0.9) << ", " << h.quantile(0.99) << ", " << h.getMoments().getMax() << std::endl;
+    }
+    const LogHistogram& cost = stats.monthlyRepairCost;
+    std::cout << "Стоимость ремонта станка за месяц: среднее " << cost.getMoments().getMean()
+              << ", СКО " << std::sqrt(cost.getMoments().variance())
+              << ", p50 " << cost.quantile(0.5) << ", p90 " << cost.quantile(0.9)
+              << ", p99 " << cost.quantile(0.99) << std::endl;
+}
+
 // Класс Станок
+// Запчасти хранятся по столбцам (struct-of-arrays): износ, пороги, множители
+// и стоимости лежат в непрерывных массивах, поэтому почасовой износ - один
+// векторизуемый цикл без указателей, счетчиков ссылок и виртуальных вызовов.
 class Stanko {
 private:
-    std::vector<std::shared_ptr<Zapchast>> parts; // Набор запчастей
+    std::vector<double> wear;               // Степень изношенности запчастей (от 0 до 100)
+    std::vector<double> thresholds;         // Износ, с которого запчасть сломана
+    std::vector<double> multipliers;        // Множитель износа за час
+    std::vector<double> repairCosts;        // Стоимость починки
+    std::vector<double> repairTimes;        // Время починки
+    std::vector<double> replacementCosts;   // Стоимость полной замены
+    std::vector<double> lifetimes;          // Срок службы до полной замены
+    std::vector<uint8_t> kinds;             // Вид запчасти (PartKind)
+    std::vector<uint8_t> brokenMask;        // 1 - запчасть сломана (обновляется вместе с износом)
     double downtime; // Время простоя
     int brokenPartsCount; // Количество сломанных частей
     double repairCost; // Общая стоимость ремонта
+    uint32_t id; // Номер станка в цехе - поток счетчикового генератора
+    MonthRecord currentMonth; // Итоги текущего месяца
+    int replacementsCount; // Количество плановых замен
+    double replacementSpend; // Стоимость плановых замен
 
 public:
-    Stanko() : downtime(0), brokenPartsCount(0), repairCost(0) {}
+    Stanko() : downtime(0), brokenPartsCount(0), repairCost(0), id(0), replacementsCount(0), replacementSpend(0) {}
+
+    uint32_t getId() const { return id; }
+    void setId(uint32_t value) { id = value; }
 
     void addPart(std::shared_ptr<Zapchast> part) {
-        parts.push_back(part);
+        wear.push_back(part->getWearLevel());
+        thresholds.push_back(part->getBreakThreshold());
+        multipliers.push_back(part->getWearMultiplier());
+        repairCosts.push_back(part->getRepairCost());
+        repairTimes.push_back(part->getRepairTime());
+        replacementCosts.push_back(part->getReplacementCost());
+        lifetimes.push_back(part->getLifetime());
+        kinds.push_back(static_cast<uint8_t>(part->getKind()));
+        brokenMask.push_back(part->isBroken());
     }
 
+    // Час износа всех запчастей: накопление, ограничение сверху и маска поломок в одном проходе
     void useParts(double usageIntensity) {
-        for (size_t i = 0; i < parts.size(); ++i) {
-            parts[i]->usePart(usageIntensity);
+        size_t n = wear.size();
+        double* level = wear.data();
+        const double* rate = multipliers.data();
+        const double* limit = thresholds.data();
+        uint8_t* mask = brokenMask.data();
+        for (size_t i = 0; i < n; ++i) {
+            double next = std::min(100.0, level[i] + usageIntensity * rate[i]);
+            level[i] = next;
+            mask[i] = next >= limit[i];
         }
     }
 
-    void work(double duration, double intensity) {
-        for (double t = 0; t < duration; t += 1) { // Проходим по времени с шагом 1
-            useParts(intensity); // Изнашиваем детали
+    /*
+     * Работа станка в течение duration часов с шагом в один час.
+     * Случайные числа часа берутся из блока (номер станка, firstHour + t),
+     * поэтому они не зависят от других станков и порядка их обхода.
+     * @param duration - длительность работы в часах.
+     * @param intensity - интенсивность работы.
+     * @param rng - генератор цеха.
+     * @param firstHour - номер первого часа в общей нумерации часов цеха.
+     * @param checkChance - вероятность проверки запчасти за час работы.
+     */
+    void work(double duration, double intensity, const CounterRng& rng, uint64_t firstHour,
+              double checkChance = 0.05) {
+        constexpr size_t BATCH = 16; // Блоки генерируются пачками
+        CounterRng::Block blocks[BATCH];
+        uint64_t checkLimit = CounterRng::chanceLimit(checkChance);
+        uint32_t n = static_cast<uint32_t>(wear.size());
+        uint64_t hours = duration > 0 ? static_cast<uint64_t>(std::ceil(duration)) : 0; // Шаги t = 0, 1, ... < duration
+
+        for (uint64_t done = 0; done < hours; done += BATCH) {
+            size_t batch = static_cast<size_t>(std::min<uint64_t>(BATCH, hours - done));
+            rng.fill(id, firstHour + done, CounterRng::HOURLY_CHECK, batch, blocks);
+            for (size_t k = 0; k < batch; ++k) {
+                useParts(intensity); // Изнашиваем детали
 
-            // Случайная вероятность поломки в процессе работы
-            if (rand() % 100 < 5) { // 5% вероятность поломки
-                int partIndex = rand() % parts.size(); // Случайно выбираем запчасть
-                if (parts[partIndex]->isBroken()) {
-                    brokenPartsCount++; // Увеличиваем счетчик поломок
-                    repairCost += parts[partIndex]->getRepairCost(); // Увеличиваем стоимость ремонта с помощью геттера
-                    downtime += parts[partIndex]->getRepairTime(); // Добавляем время ремонта
-                    // Не удаляем сломанную запчасть
+                // Случайная проверка запчасти в процессе работы
+                if (blocks[k][0] < checkLimit && n > 0) {
+                    uint32_t partIndex = CounterRng::below(blocks[k][1], n); // Случайно выбираем запчасть
+                    if (brokenMask[partIndex]) {
+                        registerBreakdown(partIndex); // Учитываем поломку, не удаляя сломанную запчасть
+                    }
                 }
             }
         }
     }
 
+    // Износ всех запчастей за hours часов работы (без проверок поломок)
+    void advanceWear(double hours, double intensity) {
+        useParts(hours * intensity);
+    }
+
+    // Учитывает ремонт сломанной запчасти, обнаруженной при проверке (count раз)
+    void registerBreakdown(size_t partIndex, int count = 1) {
+        brokenPartsCount += count;
+        repairCost += repairCosts[partIndex] * count;
+        downtime += repairTimes[partIndex] * count;
+        currentMonth.downtime += repairTimes[partIndex] * count;
+        currentMonth.repairCost += repairCosts[partIndex] * count;
+        currentMonth.failures[kinds[partIndex]] += count;
+    }
+
+    /*
+     * Плановая замена: каждая запчасть, износ которой достиг доли ratio
+     * от порога поломки, заменяется новой, пока не кончится запас.
+     * @param ratio - доля порога поломки (больше 0).
+     * @param spares - запас запчастей, уменьшается на число замен.
+     */
+    void replaceWornParts(double ratio, int& spares) {
+        for (size_t i = 0; i < wear.size() && spares > 0; ++i) {
+            if (wear[i] >= ratio * thresholds[i]) {
+                wear[i] = 0;
+                brokenMask[i] = thresholds[i] <= 0;
+                --spares;
+                replacementsCount++;
+                replacementSpend += replacementCosts[i];
+            }
+        }
+    }
+
+    int getReplacementsCount() const { return replacementsCount; }
+    double getReplacementSpend() const { return replacementSpend; }
+
+    // Станок того же состава с новыми запчастями и пустыми счетчиками
+    void restart() {
+        for (size_t i = 0; i < wear.size(); ++i) {
+            wear[i] = 0;
+            brokenMask[i] = thresholds[i] <= 0;
+        }
+        downtime = 0;
+        brokenPartsCount = 0;
+        repairCost = 0;
+        currentMonth = MonthRecord();
+        replacementsCount = 0;
+        replacementSpend = 0;
+    }
+
+    // Забирает итоги месяца и начинает следующий
+    MonthRecord closeMonth() {
+        MonthRecord record = currentMonth;
+        currentMonth = MonthRecord();
+        return record;
+    }
+
     int getBrokenPartsCount() const {
         return brokenPartsCount;
     }
@@ -183,10 +847,51 @@ public:
         return downtime;
     }
 
-    const std::vector<std::shared_ptr<Zapchast>>& getParts() const {
-        return parts; // Добавлен геттер для доступа к запчастям
+    // Полное состояние станка для контрольной точки: столбцы запчастей и счетчики
+    void saveState(StateWriter& out) const {
+        out.putColumn(wear);
+        out.putColumn(thresholds);
+        out.putColumn(multipliers);
+        out.putColumn(repairCosts);
+        out.putColumn(repairTimes);
+        out.putColumn(replacementCosts);
+        out.putColumn(lifetimes);
+        out.putColumn(kinds);
+        out.putColumn(brokenMask);
+        out.put(downtime);
+        out.put(brokenPartsCount);
+        out.put(repairCost);
+        out.put(id);
+        out.put(currentMonth);
+        out.put(replacementsCount);
+        out.put(replacementSpend);
+    }
+
+    void loadState(StateReader& in) {
+        in.getColumn(wear);
+        in.getColumn(thresholds);
+        in.getColumn(multipliers);
+        in.getColumn(repairCosts);
+        in.getColumn(repairTimes);
+        in.getColumn(replacementCosts);
+        in.getColumn(lifetimes);
+        in.getColumn(kinds);
+        in.getColumn(brokenMask);
+        downtime = in.get<double>();
+        brokenPartsCount = in.get<int>();
+        repairCost = in.get<double>();
+        id = in.get<uint32_t>();
+        currentMonth = in.get<MonthRecord>();
+        replacementsCount = in.get<int>();
+        replacementSpend = in.get<double>();
     }
 
+    size_t partCount() const { return wear.size(); }
+    double wearAt(size_t index) const { return wear[index]; }
+    double thresholdAt(size_t index) const { return thresholds[index]; }
+    double multiplierAt(size_t index) const { return multipliers[index]; }
+    bool isBroken(size_t index) const { return brokenMask[index] != 0; }
+
     void printPartsTable() const {
         std::cout << std::setw(20) << std::left << "Part Name"
                   << std::setw(15) << "Replacement Cost"
@@ -197,38 +902,233 @@ public:
 
         std::cout << std::string(85, '-') << std::endl;
 
-        for (const auto& part : parts) {
-            std::cout << *part << std::endl; // Выводим информацию о запчастях
+        for (size_t i = 0; i < partCount(); ++i) {
+            // Выводим информацию о запчастях
+            printPartRow(std::cout, partKindName(static_cast<PartKind>(kinds[i])), replacementCosts[i],
+                         repairCosts[i], repairTimes[i], lifetimes[i], wear[i]);
+            std::cout << std::endl;
         }
     }
 
     virtual ~Stanko() = default;
 };
 
+// Способ продвижения времени в симуляции
+enum class SimulationKernel {
+    Hourly,         // Шаг в один час, как в Stanko::work
+    EventDriven,    // Переходы сразу между событиями (см. Workshop::simulateYearEvents)
+    FastForward     // Месяц за O(запчастей): биномиальное число поломок между порогами
+};
+
+// Параметры годовой симуляции цеха
+struct SimulationConfig {
+    int months = 12;            // Месяцев в году
+    int daysPerMonth = 365 / 12; // Рабочих дней в месяце
+    double hoursPerDay = 12;    // Длина рабочей смены в часах
+    int intensityMin = 10;      // Наименьшая месячная интенсивность работы
+    int intensityMax = 30;      // Наибольшая месячная интенсивность работы
+    double failureCheckChance = 0.05; // Вероятность проверки запчасти за час работы
+    SimulationKernel kernel = SimulationKernel::Hourly;
+    unsigned threads = 1;       // Потоков для обхода станков (0 - по числу ядер), на итог не влияет
+    double preventiveReplacement = 0; // Доля порога поломки, с которой запчасть заменяется в начале месяца (0 - без замен)
+    int spareParts = 0;         // Запас запчастей на год для плановых замен
+};
+
+// Итоги одного прогона симуляции по всему цеху
+struct SimulationTotals {
+    double brokenParts = 0;
+    double repairCost = 0;
+    double downtime = 0;
+    double maxDowntime = 0;     // Наибольший простой одного станка
+    double replacements = 0;    // Плановые замены запчастей
+    double replacementCost = 0; // Стоимость плановых замен
+    double workDone = 0;        // Выполненная работа: интенсивность x часы смен по всем станкам
+};
+
 // Класс Цеха
 class Workshop {
 private:
     std::vector<Stanko> machines; // Набор станков
+    CounterRng rng;               // Генератор цеха (зерно и номер прогона)
+    uint64_t hourClock = 0;       // Часов работы с начала моделирования - шаг почасовых проверок
+    uint64_t monthClock = 0;      // Месяцев с начала моделирования - шаг месячных величин
+    WorkshopStats stats;          // Распределения по месяцам станков
+    int sparesLeft = 0;           // Остаток запаса запчастей на текущий год
+    double workDone = 0;          // Выполненная работа (см. SimulationTotals::workDone)
 
 public:
     void addStanko(const Stanko& stanko) {
         machines.push_back(stanko);
+        machines.back().setId(static_cast<uint32_t>(machines.size() - 1));
+    }
+
+    // Задает зерно и номер прогона; часы моделирования продолжают идти
+    void reseed(uint64_t seed, uint32_t replication = 0) {
+        rng = CounterRng(seed, replication);
+    }
+
+    /*
+     * Цех того же состава в начальном состоянии: новые запчасти, нулевые
+     * счетчики, часы и статистика. Накопленное в этом цехе не переносится,
+     * поэтому прогоны не зависят от того, что уже симулировалось в меню.
+     */
+    Workshop freshCopy() const {
+        Workshop copy;
+        copy.rng = rng;
+        copy.machines = machines;
+        for (auto& machine : copy.machines) {
+            machine.restart();
+        }
+        return copy;
     }
 
     void simulateYear() {
-        const int daysInYear = 365;
-        const double hoursPerDay = 12;
+        simulateYear(SimulationConfig());
+    }
 
-        for (int month = 0; month < 12; ++month) {
-            // Генерация случайной интенсивности работы (от 10 до 30)
-            double intensity = rand() % 21 + 10; // Случайное значение от 10 до 30
+    // Год работы цеха с заданными параметрами
+    void simulateYear(const SimulationConfig& config) {
+        for (int month = 0; month < config.months; ++month) {
+            simulateMonth(config);
+        }
+    }
 
-            for (int day = 0; day < daysInYear / 12; ++day) { // 30 дней в месяце
-                for (auto& machine : machines) {
-                    machine.work(hoursPerDay, intensity);
-                }
+    // Год работы цеха в событийной модели (см. simulateEventMonth)
+    void simulateYearEvents(const SimulationConfig& config) {
+        SimulationConfig events = config;
+        events.kernel = SimulationKernel::EventDriven;
+        simulateYear(events);
+    }
+
+    // Месяц работы цеха; номер месяца в году - monthClock по модулю config.months
+    void simulateMonth(const SimulationConfig& config) {
+        if (monthClock % std::max(1, config.months) == 0) {
+            sparesLeft = config.spareParts; // Запас пополняется в начале года
+        }
+        if (config.preventiveReplacement > 0) {
+            for (auto& machine : machines) {
+                machine.replaceWornParts(config.preventiveReplacement, sparesLeft);
             }
         }
+        double intensity = monthIntensity(config);
+        workDone += intensity * std::ceil(config.hoursPerDay) * config.daysPerMonth * machines.size();
+        if (config.kernel == SimulationKernel::EventDriven) {
+            simulateEventMonth(config, intensity);
+        } else if (config.kernel == SimulationKernel::FastForward) {
+            simulateFastForwardMonth(config, intensity);
+        } else {
+            simulateHourlyMonth(config, intensity);
+        }
+        closeMonth(static_cast<int>(monthClock % std::max(1, config.months)));
+    }
+
+    /*
+     * Многолетняя симуляция с контрольными точками. Каждые checkpointEveryMonths
+     * месяцев (и после последнего месяца) состояние цеха вместе с параметрами
+     * и числом оставшихся месяцев передается фоновому писателю.
+     * @param years - количество лет.
+     * @param config - параметры года.
+     * @param checkpointPath - файл контрольной точки (пустой - без контрольных точек).
+     * @param checkpointEveryMonths - период контрольных точек в месяцах.
+     * @throw std::runtime_error Если контрольную точку не удалось записать.
+     */
+    void simulateYears(int years, const SimulationConfig& config, const std::string& checkpointPath = "",
+                       int checkpointEveryMonths = 1) {
+        uint64_t targetMonth = monthClock + static_cast<uint64_t>(std::max(0, years)) * std::max(0, config.months);
+        runUntil(targetMonth, config, checkpointPath, checkpointEveryMonths);
+    }
+
+    /*
+     * Продолжает симуляцию, прерванную после контрольной точки: загружает
+     * состояние и досчитывает оставшиеся месяцы с теми же параметрами.
+     * Генератор счетчиковый, поэтому итог совпадает с непрерывным прогоном бит в бит.
+     * @param checkpointPath - файл контрольной точки (туда же пишутся новые).
+     * @param checkpointEveryMonths - период контрольных точек в месяцах.
+     * @throw std::runtime_error Если контрольная точка не читается или не записывается.
+     */
+    void resume(const std::string& checkpointPath, int checkpointEveryMonths = 1) {
+        SimulationConfig config;
+        uint64_t targetMonth = loadCheckpoint(checkpointPath, config);
+        runUntil(targetMonth, config, checkpointPath, checkpointEveryMonths);
+    }
+
+    // Записывает контрольную точку сразу, в текущем потоке
+    void saveCheckpoint(const std::string& path, const SimulationConfig& config, uint64_t targetMonth) const {
+        CheckpointWriter::writeFile(path, serializeCheckpoint(config, targetMonth));
+    }
+
+    /*
+     * Загружает контрольную точку, заменяя состояние цеха.
+     * @param path - файл контрольной точки.
+     * @param config - сюда записываются параметры прерванной симуляции.
+     * @return Значение monthClock, до которого нужно досчитать.
+     * @throw std::runtime_error Если файл не читается или поврежден.
+     */
+    uint64_t loadCheckpoint(const std::string& path, SimulationConfig& config) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Cannot open checkpoint: " + path);
+        }
+        CheckpointHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in || std::memcmp(header.magic, "WSC1", 4) != 0) {
+            throw std::runtime_error("Not a workshop checkpoint: " + path);
+        }
+        if (header.version != CHECKPOINT_VERSION || header.byteOrder != CHECKPOINT_BYTE_ORDER) {
+            throw std::runtime_error("Unsupported checkpoint version or byte order: " + path);
+        }
+        // Размер состояния сверяется с длиной файла до выделения памяти под него
+        std::streamoff payloadStart = in.tellg();
+        in.seekg(0, std::ios::end);
+        uint64_t available = static_cast<uint64_t>(in.tellg() - payloadStart);
+        in.seekg(payloadStart);
+        if (!in || header.payloadSize > available) {
+            throw std::runtime_error("Checkpoint is truncated or corrupted: " + path);
+        }
+        std::string payload(static_cast<size_t>(header.payloadSize), '\0');
+        in.read(&payload[0], static_cast<std::streamsize>(payload.size()));
+        if (!in || checksum(payload) != header.checksum) {
+            throw std::runtime_error("Checkpoint is truncated or corrupted: " + path);
+        }
+
+        StateReader reader(payload);
+        uint64_t targetMonth = reader.get<uint64_t>();
+        config.months = reader.get<int>();
+        config.daysPerMonth = reader.get<int>();
+        config.hoursPerDay = reader.get<double>();
+        config.intensityMin = reader.get<int>();
+        config.intensityMax = reader.get<int>();
+        config.failureCheckChance = reader.get<double>();
+        config.kernel = static_cast<SimulationKernel>(reader.get<uint8_t>());
+        config.preventiveReplacement = reader.get<double>();
+        config.spareParts = reader.get<int>();
+
+        rng.loadState(reader);
+        hourClock = reader.get<uint64_t>();
+        monthClock = reader.get<uint64_t>();
+        sparesLeft = reader.get<int>();
+        workDone = reader.get<double>();
+        stats.loadState(reader);
+        machines.resize(static_cast<size_t>(reader.get<uint64_t>()));
+        for (auto& machine : machines) {
+            machine.loadState(reader);
+        }
+        return targetMonth;
+    }
+
+    // Итоговые показатели цеха
+    SimulationTotals totals() const {
+        SimulationTotals result;
+        for (const auto& machine : machines) {
+            result.brokenParts += machine.getBrokenPartsCount();
+            result.repairCost += machine.getRepairCost();
+            result.downtime += machine.getDowntime();
+            result.maxDowntime = std::max(result.maxDowntime, machine.getDowntime());
+            result.replacements += machine.getReplacementsCount();
+            result.replacementCost += machine.getReplacementSpend();
+        }
+        result.workDone = workDone;
+        return result;
     }
 
     void printStatistics() const {
@@ -249,15 +1149,636 @@ public:
         std::cout << "Общая стоимость ремонта: " << totalRepairCost << std::endl;
         std::cout << "Общее время простоя: " << totalDowntime << std::endl;
         std::cout << "Максимальное время простоя: " << maxDowntime << std::endl;
+        SimulationTotals summary = totals();
+        if (summary.replacements > 0) {
+            std::cout << "Плановых замен: " << summary.replacements
+                      << ", их стоимость: " << summary.replacementCost << std::endl;
+        }
+        printWorkshopStats(stats);
     }
 
+    const WorkshopStats& getStats() const { return stats; }
+
     void printAllMachines() const {
         for (const auto& machine : machines) {
             machine.printPartsTable(); // Выводим информацию о запчастях каждого станка
         }
     }
+
+private:
+    // Через сколько часов работы запчасть станет сломанной (0 - уже сломана, -1 - никогда)
+    static long long ticksUntilBroken(const Stanko& machine, size_t part, double intensity) {
+        double threshold = machine.thresholdAt(part);
+        if (machine.wearAt(part) >= threshold) {
+            return 0;
+        }
+        double rate = intensity * machine.multiplierAt(part);
+        if (threshold > 100 || rate <= 0) {
+            return -1;
+        }
+        return std::max(1LL, static_cast<long long>(std::ceil((threshold - machine.wearAt(part)) / rate)));
+    }
+
+    // Заголовок контрольной точки; за ним payloadSize байт состояния
+    struct CheckpointHeader {
+        char magic[4];          // "WSC1"
+        uint32_t version;       // Версия формата
+        uint32_t byteOrder;     // 0x01020304 в порядке байт записавшей машины
+        uint32_t reserved;
+        uint64_t payloadSize;
+        uint64_t checksum;      // FNV-1a от состояния
+    };
+    static const uint32_t CHECKPOINT_VERSION = 3;
+    static const uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304;
+
+    static uint64_t checksum(const std::string& bytes) {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        for (unsigned char c : bytes) {
+            hash = (hash ^ c) * 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    std::string serializeCheckpoint(const SimulationConfig& config, uint64_t targetMonth) const {
+        StateWriter writer;
+        writer.put(targetMonth);
+        writer.put(config.months);
+        writer.put(config.daysPerMonth);
+        writer.put(config.hoursPerDay);
+        writer.put(config.intensityMin);
+        writer.put(config.intensityMax);
+        writer.put(config.failureCheckChance);
+        writer.put(static_cast<uint8_t>(config.kernel));
+        writer.put(config.preventiveReplacement);
+        writer.put(config.spareParts);
+
+        rng.saveState(writer);
+        writer.put(hourClock);
+        writer.put(monthClock);
+        writer.put(sparesLeft);
+        writer.put(workDone);
+        stats.saveState(writer);
+        writer.put(static_cast<uint64_t>(machines.size()));
+        for (const auto& machine : machines) {
+            machine.saveState(writer);
+        }
+
+        CheckpointHeader header = {};
+        std::memcpy(header.magic, "WSC1", 4);
+        header.version = CHECKPOINT_VERSION;
+        header.byteOrder = CHECKPOINT_BYTE_ORDER;
+        header.payloadSize = writer.bytes.size();
+        header.checksum = checksum(writer.bytes);
+        return std::string(reinterpret_cast<const char*>(&header), sizeof(header)) + writer.bytes;
+    }
+
+    // Месяцы до targetMonth; контрольные точки сериализуются здесь, а пишутся в фоне
+    void runUntil(uint64_t targetMonth, const SimulationConfig& config, const std::string& checkpointPath,
+                  int checkpointEveryMonths) {
+        std::unique_ptr<CheckpointWriter> writer;
+        if (!checkpointPath.empty()) {
+            writer.reset(new CheckpointWriter(checkpointPath));
+        }
+        uint64_t every = static_cast<uint64_t>(std::max(1, checkpointEveryMonths));
+        while (monthClock < targetMonth) {
+            simulateMonth(config);
+            if (writer && (monthClock % every == 0 || monthClock == targetMonth)) {
+                writer->submit(serializeCheckpoint(config, targetMonth));
+            }
+        }
+        if (writer) {
+            writer->finish();
+        }
+    }
+
+    // Почасовая модель месяца: ceil(hoursPerDay) часовых шагов Stanko::work за смену
+    void simulateHourlyMonth(const SimulationConfig& config, double intensity) {
+        uint64_t ticksPerDay = static_cast<uint64_t>(std::ceil(config.hoursPerDay));
+        forEachMachine(config.threads, [&](Stanko& machine) {
+            for (int day = 0; day < config.daysPerMonth; ++day) {
+                machine.work(config.hoursPerDay, intensity, rng, hourClock + day * ticksPerDay,
+                             config.failureCheckChance);
+            }
+        });
+        hourClock += ticksPerDay * config.daysPerMonth;
+    }
+
+    /*
+     * Событийная модель месяца: вместо почасового шага время переходит сразу
+     * к ближайшему событию.
+     *
+     * В течение месяца интенсивность постоянна, поэтому износ каждой запчасти
+     * растет линейно и час ее поломки вычисляется заранее (событие порога).
+     * Проверки поломок в почасовой модели - независимые испытания с вероятностью
+     * failureCheckChance, поэтому интервал до следующей проверки станка имеет
+     * геометрическое распределение; по отсутствию памяти его можно заново
+     * разыгрывать в начале каждого месяца. При проверке выбирается случайная
+     * запчасть и, если она сломана, учитывается ремонт.
+     *
+     * Станки за месяц независимы, поэтому очередь событий ведется для каждого
+     * станка отдельно: упорядоченные события порогов сливаются с потоком проверок.
+     * Распределение итогов совпадает с почасовой моделью, а работа пропорциональна
+     * числу событий, а не числу часов.
+     * @param config - параметры года.
+     * @param intensity - интенсивность месяца.
+     */
+    void simulateEventMonth(const SimulationConfig& config, double intensity) {
+        long long ticksPerDay = static_cast<long long>(std::ceil(config.hoursPerDay));
+        long long monthTicks = ticksPerDay * config.daysPerMonth;
+        double p = config.failureCheckChance;
+        double logMiss = p > 0 && p < 1 ? std::log1p(-p) : 0;
+        uint64_t monthStep = monthClock << 32; // Младшие 32 бита шага - номер проверки в месяце
+
+        forEachMachine(config.threads, [&](Stanko& machine) {
+            size_t partCount = machine.partCount();
+            if (partCount == 0 || p <= 0) {
+                machine.advanceWear(static_cast<double>(monthTicks), intensity);
+                return;
+            }
+            // Событие порога: час внутри месяца (от 1), когда запчасть становится сломанной
+            std::vector<std::pair<long long, size_t>> thresholds;
+            std::vector<char> broken(partCount, 0);
+            for (size_t part = 0; part < partCount; ++part) {
+                long long crossing = ticksUntilBroken(machine, part, intensity);
+                broken[part] = crossing == 0;
+                if (crossing > 0 && crossing <= monthTicks) {
+                    thresholds.push_back({crossing, part});
+                }
+            }
+            std::sort(thresholds.begin(), thresholds.end());
+
+            // Проверка k: слова 0-1 - интервал до нее (геометрическое распределение), слово 2 - запчасть
+            size_t nextThreshold = 0;
+            long long tick = 0;
+            for (uint64_t check = 0;; ++check) {
+                CounterRng::Block draw = rng.block(machine.getId(), monthStep + check, CounterRng::EVENT_CHECK);
+                long long gap = 1;
+                if (logMiss < 0) {
+                    double misses = std::floor(std::log1p(-CounterRng::uniform(draw[0], draw[1])) / logMiss);
+                    gap += misses < static_cast<double>(monthTicks) ? static_cast<long long>(misses) : monthTicks;
+                }
+                tick += gap;
+                if (tick > monthTicks) {
+                    break;
+                }
+                // Износ за час предшествует проверке в том же часе
+                while (nextThreshold < thresholds.size() && thresholds[nextThreshold].first <= tick) {
+                    broken[thresholds[nextThreshold++].second] = 1;
+                }
+                size_t part = CounterRng::below(draw[2], static_cast<uint32_t>(partCount));
+                if (broken[part]) {
+                    machine.registerBreakdown(part);
+                }
+            }
+            machine.advanceWear(static_cast<double>(monthTicks), intensity);
+        });
+        hourClock += monthTicks;
+    }
+
+    /*
+     * Аналитическая модель месяца. Часы поломок запчастей вычисляются заранее
+     * (износ линеен), и месяц делится ими на отрезки, на которых набор сломанных
+     * запчастей не меняется. В часе отрезка проверка находит сломанную запчасть
+     * с вероятностью failureCheckChance * B / n (B из n запчастей сломаны),
+     * поэтому число найденных поломок на отрезке - биномиальное. Найденные
+     * поломки делятся между сломанными запчастями поровну по вероятности
+     * (полиномиальное распределение через последовательные биномиальные).
+     * Распределение итогов совпадает с почасовой моделью. Работа за месяц -
+     * O(n) отрезков; только в месяц, когда ломается много запчастей, деление
+     * поломок добавляет O(n) на отрезок.
+     * Биномиальные числа берутся из потока Philox станка (CounterRng::binomial),
+     * поэтому итог не зависит от числа потоков.
+     * @param config - параметры года.
+     * @param intensity - интенсивность месяца.
+     */
+    void simulateFastForwardMonth(const SimulationConfig& config, double intensity) {
+        long long ticksPerDay = static_cast<long long>(std::ceil(config.hoursPerDay));
+        long long monthTicks = ticksPerDay * config.daysPerMonth;
+        double p = std::min(1.0, config.failureCheckChance);
+
+        forEachMachine(config.threads, [&](Stanko& machine) {
+            size_t partCount = machine.partCount();
+            if (partCount == 0 || p <= 0) {
+                machine.advanceWear(static_cast<double>(monthTicks), intensity);
+                return;
+            }
+            // Первый час месяца, в котором запчасть сломана (уже сломанные - с часа 1)
+            std::vector<std::pair<long long, size_t>> crossings;
+            for (size_t part = 0; part < partCount; ++part) {
+                long long crossing = ticksUntilBroken(machine, part, intensity);
+                if (crossing >= 0 && crossing <= monthTicks) {
+                    crossings.push_back({std::max(1LL, crossing), part});
+                }
+            }
+            std::sort(crossings.begin(), crossings.end());
+
+            CounterRng::Stream draws(rng, machine.getId(), monthClock << 32, CounterRng::FAST_FORWARD);
+            double hitChance = p / partCount; // Проверка нашла данную сломанную запчасть
+            for (size_t k = 0; k < crossings.size(); ++k) {
+                long long from = crossings[k].first;
+                long long to = k + 1 < crossings.size() ? crossings[k + 1].first : monthTicks + 1;
+                if (to == from) {
+                    continue;
+                }
+                size_t brokenCount = k + 1;
+                int hits = CounterRng::binomial(draws, static_cast<int>(to - from), hitChance * brokenCount);
+                for (size_t j = 0; j <= k && hits > 0; ++j) {
+                    int share = j == k ? hits : CounterRng::binomial(draws, hits, 1.0 / (brokenCount - j));
+                    if (share > 0) {
+                        machine.registerBreakdown(crossings[j].second, share);
+                        hits -= share;
+                    }
+                }
+            }
+            machine.advanceWear(static_cast<double>(monthTicks), intensity);
+        });
+        hourClock += monthTicks;
+    }
+
+    // Переносит итоги месяца станков в статистику (по порядку станков) и переводит часы
+    void closeMonth(int month) {
+        for (auto& machine : machines) {
+            stats.record(month, machine.closeMonth());
+        }
+        ++monthClock;
+    }
+
+    // Интенсивность текущего месяца (одна на весь цех)
+    double monthIntensity(const SimulationConfig& config) const {
+        CounterRng::Block draw = rng.block(CounterRng::WORKSHOP_STREAM, monthClock, CounterRng::MONTH_INTENSITY);
+        uint32_t range = static_cast<uint32_t>(config.intensityMax - config.intensityMin + 1);
+        return config.intensityMin + static_cast<int>(CounterRng::below(draw[0], range));
+    }
+
+    // Применяет action к каждому станку; станки делятся между потоками непрерывными кусками
+    template <typename Action>
+    void forEachMachine(unsigned threads, Action action) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = static_cast<unsigned>(std::min<size_t>(threads, machines.size()));
+        if (threads <= 1) {
+            for (auto& machine : machines) {
+                action(machine);
+            }
+            return;
+        }
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            size_t begin = machines.size() * t / threads;
+            size_t end = machines.size() * (t + 1) / threads;
+            pool.emplace_back([this, begin, end, &action]() {
+                for (size_t i = begin; i < end; ++i) {
+                    action(machines[i]);
+                }
+            });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+};
+
+// Выборочные характеристики одного показателя по прогонам
+struct MetricSummary {
+    double mean = 0;
+    double variance = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p95 = 0;
+    double p99 = 0;
+};
+
+// Итоги моделирования методом Монте-Карло
+struct MonteCarloSummary {
+    int replications = 0;
+    MetricSummary brokenParts;
+    MetricSummary repairCost;
+    MetricSummary downtime;
+    MetricSummary maxDowntime;
+    WorkshopStats stats;        // Распределения, объединенные по всем прогонам
+};
+
+/*
+ * Считает среднее, несмещенную дисперсию и перцентили (с линейной интерполяцией).
+ * Значения суммируются в исходном порядке, поэтому результат воспроизводим.
+ */
+MetricSummary summarizeMetric(std::vector<double> values) {
+    MetricSummary summary;
+    if (values.empty()) {
+        return summary;
+    }
+    double sum = 0;
+    for (double value : values) {
+        sum += value;
+    }
+    summary.mean = sum / values.size();
+    double squares = 0;
+    for (double value : values) {
+        squares += (value - summary.mean) * (value - summary.mean);
+    }
+    summary.variance = values.size() > 1 ? squares / (values.size() - 1) : 0;
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&values](double q) {
+        double position = q * (values.size() - 1);
+        size_t low = static_cast<size_t>(std::floor(position));
+        size_t high = std::min(low + 1, values.size() - 1);
+        return values[low] + (values[high] - values[low]) * (position - low);
+    };
+    summary.p50 = percentile(0.50);
+    summary.p90 = percentile(0.90);
+    summary.p95 = percentile(0.95);
+    summary.p99 = percentile(0.99);
+    return summary;
+}
+
+/*
+ * Моделирование года работы цеха методом Монте-Карло.
+ * Каждый прогон работает с собственной копией цеха в начальном состоянии
+ * (см. Workshop::freshCopy), а ключ счетчикового генератора выводится из общего
+ * зерна и номера прогона. Прогоны раздаются рабочим потокам блоками по
+ * REPLICATION_BLOCK; статистика блока объединяется в порядке прогонов, а блоки -
+ * в порядке номеров, поэтому итог зависит только от общего зерна, но не от
+ * числа потоков и не от того, что уже симулировалось в исходном цехе.
+ * @param prototype - исходный цех (берется только состав станков и запчастей).
+ * @param replications - количество прогонов.
+ * @param masterSeed - общее зерно.
+ * @param config - параметры года.
+ * @param threads - количество потоков (0 - по числу ядер).
+ * @return Сводка по прогонам.
+ */
+MonteCarloSummary runMonteCarlo(const Workshop& prototype, int replications, uint64_t masterSeed,
+                                const SimulationConfig& config, unsigned threads = 0) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    constexpr int REPLICATION_BLOCK = 64;
+    std::vector<SimulationTotals> results(std::max(0, replications));
+    std::vector<WorkshopStats> blockStats((results.size() + REPLICATION_BLOCK - 1) / REPLICATION_BLOCK);
+    std::atomic<int> nextBlock(0);
+    SimulationConfig yearConfig = config;
+    yearConfig.threads = 1; // Параллельны прогоны, а не станки внутри прогона
+
+    auto worker = [&]() {
+        for (int block = nextBlock++; block < static_cast<int>(blockStats.size()); block = nextBlock++) {
+            int last = std::min(replications, (block + 1) * REPLICATION_BLOCK);
+            for (int r = block * REPLICATION_BLOCK; r < last; ++r) {
+                Workshop workshop = prototype.freshCopy(); // Каждый прогон начинается с нового цеха
+                workshop.reseed(masterSeed, static_cast<uint32_t>(r));
+                workshop.simulateYear(yearConfig);
+                results[r] = workshop.totals();
+                blockStats[block].merge(workshop.getStats());
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    MonteCarloSummary summary;
+    summary.replications = static_cast<int>(results.size());
+    std::vector<double> values(results.size());
+    auto collect = [&](double SimulationTotals::*field) {
+        for (size_t i = 0; i < results.size(); ++i) {
+            values[i] = results[i].*field;
+        }
+        return summarizeMetric(values);
+    };
+    summary.brokenParts = collect(&SimulationTotals::brokenParts);
+    summary.repairCost = collect(&SimulationTotals::repairCost);
+    summary.downtime = collect(&SimulationTotals::downtime);
+    summary.maxDowntime = collect(&SimulationTotals::maxDowntime);
+    for (const auto& block : blockStats) {
+        summary.stats.merge(block);
+    }
+    return summary;
+}
+
+void printMonteCarlo(const MonteCarloSummary& summary) {
+    std::cout << "Моделирование Монте-Карло, прогонов: " << summary.replications << std::endl;
+    auto row = [](const char* name, const MetricSummary& m) {
+        std::cout << name << ": среднее " << m.mean << ", СКО " << std::sqrt(m.variance)
+                  << ", p50 " << m.p50 << ", p90 " << m.p90
+                  << ", p95 " << m.p95 << ", p99 " << m.p99 << std::endl;
+    };
+    row("Сломанные запчасти", summary.brokenParts);
+    row("Стоимость ремонта", summary.repairCost);
+    row("Время простоя", summary.downtime);
+    row("Наибольший простой станка", summary.maxDowntime);
+    printWorkshopStats(summary.stats);
+}
+
+// Политика обслуживания - одна точка перебора
+struct PolicyParams {
+    double preventiveReplacement = 0; // Доля порога поломки для плановой замены (0 - без замен)
+    int spareParts = 0;               // Запас запчастей на год
+    double hoursPerDay = 12;          // Длина смены
+    int intensityMin = 10;            // Диапазон месячной интенсивности
+    int intensityMax = 30;
+};
+
+// Общие параметры перебора (только чтение во время работы)
+struct SweepSettings {
+    uint64_t seed = 1;
+    int batchReplications = 32;       // Прогонов сценария за один раунд
+    int maxReplications = 512;        // Наибольшее число прогонов сценария
+    double downtimeCostPerHour = 40;  // Цена часа простоя станка
+    double spareHoldingCost = 30;     // Цена хранения одной запчасти в год
+    SimulationConfig base;            // Остальные параметры года
+    unsigned threads = 0;             // 0 - по числу ядер
+};
+
+// Результат сценария: моменты стоимости единицы работы по прогонам
+struct ScenarioResult {
+    PolicyParams params;
+    RunningMoments cost;
+    bool pruned = false;              // Отсеян: доверительный интервал целиком хуже лучшего
+
+    // Полуширина 95% доверительного интервала среднего
+    double halfWidth() const {
+        return cost.count() > 1 ? 1.96 * std::sqrt(cost.variance() / cost.count()) : INFINITY;
+    }
 };
 
+// Декартово произведение значений параметров
+std::vector<PolicyParams> policyGrid(const std::vector<double>& replacementRatios, const std::vector<int>& spares,
+                                     const std::vector<double>& shifts,
+                                     const std::vector<std::pair<int, int>>& intensities) {
+    std::vector<PolicyParams> grid;
+    for (double ratio : replacementRatios) {
+        for (int stock : spares) {
+            for (double shift : shifts) {
+                for (const auto& range : intensities) {
+                    PolicyParams params;
+                    params.preventiveReplacement = ratio;
+                    params.spareParts = stock;
+                    params.hoursPerDay = shift;
+                    params.intensityMin = range.first;
+                    params.intensityMax = range.second;
+                    grid.push_back(params);
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+/*
+ * Случайные политики, равномерно между low и high по каждому параметру.
+ * Диапазон интенсивности строится из двух случайных чисел в [low.intensityMin, high.intensityMax].
+ */
+std::vector<PolicyParams> randomPolicies(int count, uint64_t seed, const PolicyParams& low, const PolicyParams& high) {
+    CounterRng rng(seed);
+    std::vector<PolicyParams> policies;
+    for (int i = 0; i < count; ++i) {
+        CounterRng::Block a = rng.block(static_cast<uint32_t>(i), 0, 0);
+        CounterRng::Block b = rng.block(static_cast<uint32_t>(i), 1, 0);
+        auto between = [](uint32_t word, int from, int to) {
+            return from + static_cast<int>(CounterRng::below(word, static_cast<uint32_t>(to - from + 1)));
+        };
+        PolicyParams params;
+        params.preventiveReplacement = low.preventiveReplacement +
+            CounterRng::uniform(a[0], a[1]) * (high.preventiveReplacement - low.preventiveReplacement);
+        params.spareParts = between(a[2], low.spareParts, high.spareParts);
+        params.hoursPerDay = between(a[3], static_cast<int>(low.hoursPerDay), static_cast<int>(high.hoursPerDay));
+        int first = between(b[0], low.intensityMin, high.intensityMax);
+        int second = between(b[1], low.intensityMin, high.intensityMax);
+        params.intensityMin = std::min(first, second);
+        params.intensityMax = std::max(first, second);
+        policies.push_back(params);
+    }
+    return policies;
+}
+
+/*
+ * Полная стоимость года (ремонты, плановые замены, простой и хранение запаса)
+ * на единицу выполненной работы. Смена и интенсивность задают объем работы,
+ * поэтому без нормировки короткие и легкие смены всегда оказывались бы дешевле.
+ */
+double policyCost(const SimulationTotals& totals, const PolicyParams& params, const SweepSettings& settings) {
+    double cost = totals.repairCost + totals.replacementCost + totals.downtime * settings.downtimeCostPerHour +
+                  params.spareParts * settings.spareHoldingCost;
+    return totals.workDone > 0 ? cost / totals.workDone : INFINITY;
+}
+
+/*
+ * Перебор политик обслуживания по стоимости единицы работы (см. policyCost).
+ * Раунд дает каждому оставшемуся сценарию batchReplications новых прогонов;
+ * пары (сценарий, прогон) раздаются потокам, и каждый прогон начинается
+ * с нового цеха того же состава (Workshop::freshCopy). Прогон r каждого сценария
+ * использует одно и то же зерно (общие случайные числа), поэтому сценарии
+ * сравниваются на одинаковых случайных событиях. После раунда результаты
+ * добавляются в порядке прогонов, и сценарий отсеивается, если нижняя граница
+ * его 95% доверительного интервала выше верхней границы лучшего сценария.
+ * @param prototype - исходный цех (берется только состав станков и запчастей).
+ * @param scenarios - политики для перебора.
+ * @param settings - общие параметры.
+ * @return Результаты, упорядоченные по средней стоимости единицы работы.
+ */
+std::vector<ScenarioResult> runPolicySweep(const Workshop& prototype, const std::vector<PolicyParams>& scenarios,
+                                           const SweepSettings& settings) {
+    unsigned threads = settings.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    int batch = std::max(1, settings.batchReplications);
+    std::vector<ScenarioResult> results(scenarios.size());
+    std::vector<SimulationConfig> configs(scenarios.size(), settings.base);
+    for (size_t i = 0; i < scenarios.size(); ++i) {
+        results[i].params = scenarios[i];
+        configs[i].threads = 1;
+        configs[i].preventiveReplacement = scenarios[i].preventiveReplacement;
+        configs[i].spareParts = scenarios[i].spareParts;
+        configs[i].hoursPerDay = scenarios[i].hoursPerDay;
+        configs[i].intensityMin = scenarios[i].intensityMin;
+        configs[i].intensityMax = scenarios[i].intensityMax;
+    }
+
+    std::vector<size_t> active(scenarios.size());
+    for (size_t i = 0; i < active.size(); ++i) {
+        active[i] = i;
+    }
+    std::vector<double> costs;
+    for (int done = 0; done < settings.maxReplications && !active.empty(); done += batch) {
+        int count = std::min(batch, settings.maxReplications - done);
+        size_t jobs = active.size() * count;
+        costs.assign(jobs, 0);
+        std::atomic<size_t> nextJob(0);
+        auto worker = [&]() {
+            for (size_t job = nextJob++; job < jobs; job = nextJob++) {
+                size_t scenario = active[job / count];
+                int replication = done + static_cast<int>(job % count);
+                Workshop workshop = prototype.freshCopy();
+                workshop.reseed(settings.seed, static_cast<uint32_t>(replication));
+                workshop.simulateYear(configs[scenario]);
+                costs[job] = policyCost(workshop.totals(), scenarios[scenario], settings);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned i = 0; i < std::min<size_t>(threads, jobs); ++i) {
+            pool.emplace_back(worker);
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        double bestUpper = INFINITY;
+        for (size_t k = 0; k < active.size(); ++k) {
+            ScenarioResult& result = results[active[k]];
+            for (int r = 0; r < count; ++r) {
+                result.cost.add(costs[k * count + r]);
+            }
+            bestUpper = std::min(bestUpper, result.cost.getMean() + result.halfWidth());
+        }
+        std::vector<size_t> survivors;
+        for (size_t scenario : active) {
+            ScenarioResult& result = results[scenario];
+            if (result.cost.getMean() - result.halfWidth() > bestUpper) {
+                result.pruned = true;
+            } else {
+                survivors.push_back(scenario);
+            }
+        }
+        active.swap(survivors);
+    }
+
+    std::stable_sort(results.begin(), results.end(), [](const ScenarioResult& a, const ScenarioResult& b) {
+        return a.cost.getMean() < b.cost.getMean();
+    });
+    return results;
+}
+
+void printPolicySweep(const std::vector<ScenarioResult>& results) {
+    std::cout << std::setw(5) << std::left << "Rank"
+              << std::setw(10) << "Replace"
+              << std::setw(8) << "Spares"
+              << std::setw(7) << "Shift"
+              << std::setw(11) << "Intensity"
+              << std::setw(14) << "Cost/unit"
+              << std::setw(12) << "95% CI +-"
+              << std::setw(6) << "Runs"
+              << "Status" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ScenarioResult& result = results[i];
+        std::string intensity = std::to_string(result.params.intensityMin) + "-" + std::to_string(result.params.intensityMax);
+        std::cout << std::setw(5) << i + 1
+                  << std::setw(10) << result.params.preventiveReplacement
+                  << std::setw(8) << result.params.spareParts
+                  << std::setw(7) << result.params.hoursPerDay
+                  << std::setw(11) << intensity
+                  << std::setw(14) << std::fixed << std::setprecision(4) << result.cost.getMean()
+                  << std::setw(12) << result.halfWidth() << std::defaultfloat << std::setprecision(6)
+                  << std::setw(6) << result.cost.count()
+                  << (result.pruned ? "pruned" : "") << std::endl;
+    }
+}
+
 std::shared_ptr<Zapchast> createPart() {
     int partType;
     std::cout << "Выберите тип запчасти:" << std::endl;
@@ -302,6 +1823,11 @@ void userInterface(Workshop& workshop) {
         std::cout << "2. Показать информацию о станках" << std::endl;
         std::cout << "3. Симулировать работу цеха за год" << std::endl;
         std::cout << "4. Показать статистику работы цеха" << std::endl;
+        std::cout << "5. Моделирование Монте-Карло" << std::endl;
+        std::cout << "6. Симулировать работу цеха за год (событийная модель)" << std::endl;
+        std::cout << "7. Многолетняя симуляция с контрольными точками" << std::endl;
+        std::cout << "8. Продолжить симуляцию с контрольной точки" << std::endl;
+        std::cout << "9. Подбор политики обслуживания" << std::endl;
         std::cout << "0. Выйти" << std::endl;
         std::cin >> choice;
 
@@ -333,6 +1859,85 @@ void userInterface(Workshop& workshop) {
             case 4:
                 workshop.printStatistics();
                 break;
+            case 5: {
+                int replications;
+                uint64_t seed;
+                std::cout << "Количество прогонов: ";
+                std::cin >> replications;
+                std::cout << "Зерно генератора: ";
+                std::cin >> seed;
+                int kernel;
+                std::cout << "Модель (1 - почасовая, 2 - событийная, 3 - аналитическая): ";
+                std::cin >> kernel;
+                SimulationConfig config;
+                if (kernel == 2) {
+                    config.kernel = SimulationKernel::EventDriven;
+                } else if (kernel == 3) {
+                    config.kernel = SimulationKernel::FastForward;
+                }
+                printMonteCarlo(runMonteCarlo(workshop, replications, seed, config));
+                break;
+            }
+            case 6:
+                workshop.simulateYearEvents(SimulationConfig());
+                std::cout << "Симуляция работы цеха завершена." << std::endl;
+                break;
+            case 7: {
+                int years, everyMonths;
+                std::string path;
+                std::cout << "Количество лет: ";
+                std::cin >> years;
+                std::cout << "Файл контрольной точки: ";
+                std::cin >> path;
+                std::cout << "Период контрольных точек (в месяцах): ";
+                std::cin >> everyMonths;
+                try {
+                    workshop.simulateYears(years, SimulationConfig(), path, everyMonths);
+                    std::cout << "Симуляция работы цеха завершена." << std::endl;
+                } catch (const std::runtime_error& e) {
+                    std::cout << e.what() << std::endl;
+                }
+                break;
+            }
+            case 8: {
+                std::string path;
+                std::cout << "Файл контрольной точки: ";
+                std::cin >> path;
+                try {
+                    workshop.resume(path);
+                    std::cout << "Симуляция работы цеха завершена." << std::endl;
+                } catch (const std::runtime_error& e) {
+                    std::cout << e.what() << std::endl;
+                }
+                break;
+            }
+            case 9: {
+                int mode;
+                SweepSettings settings;
+                settings.base.kernel = SimulationKernel::EventDriven;
+                std::cout << "Сценарии (1 - сетка, 2 - случайные): ";
+                std::cin >> mode;
+                std::cout << "Зерно генератора: ";
+                std::cin >> settings.seed;
+                std::vector<PolicyParams> scenarios;
+                if (mode == 2) {
+                    int count;
+                    std::cout << "Количество сценариев: ";
+                    std::cin >> count;
+                    PolicyParams low, high;
+                    low.spareParts = 0;
+                    high.spareParts = 200;
+                    low.hoursPerDay = 8;
+                    high.hoursPerDay = 16;
+                    high.preventiveReplacement = 1;
+                    scenarios = randomPolicies(count, settings.seed, low, high);
+                } else {
+                    scenarios = policyGrid({0, 0.6, 0.8, 0.95}, {20, 60, 150}, {8, 12},
+                                           {{10, 30}, {15, 20}});
+                }
+                printPolicySweep(runPolicySweep(workshop, scenarios, settings));
+                break;
+            }
             case 0:
                 std::cout << "Выход из программы." << std::endl;
                 break;
@@ -343,9 +1948,8 @@ void userInterface(Workshop& workshop) {
 }
 
 int main() {
-    srand(static_cast<unsigned int>(time(0))); // Инициализация генератора случайных чисел
-
     Workshop workshop;
+    workshop.reseed(static_cast<uint64_t>(time(0))); // Инициализация генератора случайных чисел
 
     // Создание начальных станков и добавление запчастей
     for (int i = 0; i < 5; ++i) { // 5 станков
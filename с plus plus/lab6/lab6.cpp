@@ -1,326 +1,1559 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <memory>
 #include <algorithm>
 #include <random>
 #include <cmath>
 #include <climits>
 #include <iomanip> // Для std::setw и std::setfill
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
 
 using namespace std;
 
 /*
- * Базовый класс для бойцов.
+ * Генератор случайных чисел боя (xoshiro256**): у каждого боя свой.
+ * Состояние - четыре слова, заполняемые SplitMix64 из зерна, поэтому
+ * создать генератор для отдельного боя почти ничего не стоит (в отличие
+ * от mt19937 с seed_seq, чья инициализация дороже самого боя 5 на 5).
  */
-class Fighter {
-protected:
-    string fighterName; // Имя бойца
-    int healthPoints;   // Текущее здоровье бойца
-    int defenseArmor;   // Броня бойца
-    int extraDamage;    // Бонусный урон
-    int attackSpeed;    // Инициатива бойца
-    bool isFighterAlive; // Статус живости бойца
-    int teamID;          // Номер команды, к которой принадлежит боец
-    int posX, posY;      // Позиция бойца на поле (координаты)
+class BattleRng {
+public:
+    using result_type = uint64_t;
+
+    explicit BattleRng(uint64_t seed = 1, uint64_t stream = 0) {
+        uint64_t mix = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+        for (auto& word : state) {
+            mix += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = mix;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~0ULL; }
+
+    result_type operator()() {
+        uint64_t result = rotate(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate(state[3], 45);
+        return result;
+    }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotate(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+// Бросок кубика с sides гранями (от 1 до sides)
+inline int rollDie(BattleRng& rng, int sides) {
+    return uniform_int_distribution<int>(1, sides)(rng);
+}
+
+// Виды бойцов (столбец type хранилища)
+enum FighterType : uint8_t {
+    WARRIOR,
+    ARCHER,
+    MAGE,
+    FIGHTER_TYPE_COUNT
+};
 
 /*
-     * Конструктор для создания бойца.
-     *
-     * @param name Имя бойца.
-     * @param health Здоровье бойца.
-     * @param armor Броня бойца.
-     * @param damage Бонусный урон.
-     * @param speed Инициатива бойца.
-     * @param team Номер команды.
-     * @param xPos Позиция по оси X.
-     * @param yPos Позиция по оси Y.
-     */
-public:
-    Fighter(string name, int health, int armor, int bonusDamage, int initiative, int teamNum, int xPos, int yPos)
-        : fighterName(name), healthPoints(health), defenseArmor(armor), extraDamage(bonusDamage), attackSpeed(initiative), isFighterAlive(true), teamID(teamNum), posX(xPos), posY(yPos) {}
+ * Свойства вида бойца. Воин, лучник и маг различаются только числами и
+ * текстом атаки, поэтому вид - строка таблицы, а не подкласс.
+ */
+struct FighterKind {
+    const char* namePrefix; // Имя бойца - префикс и номер в команде
+    int health;             // Начальное здоровье
+    int armor;              // Броня
+    int bonusDamage;        // Бонусный урон
+    int speed;              // Клеток за ход
+    int range;              // Дальность атаки (манхэттенская)
+    // Текст атаки (без строки об оставшемся здоровье)
+    void (*printAttack)(ostream& os, const string& attacker, int attackerTeam, const string& target,
+                        int targetTeam, int damage);
+};
 
-    virtual ~Fighter() {}
+// Наибольшая скорость среди видов бойцов
+constexpr int MAX_FIGHTER_SPEED = 2;
 
-    virtual void attack(Fighter& enemy) = 0;
-    virtual void move(int targetX, int targetY) = 0;
-    bool alive() const { return isFighterAlive; }
+static const FighterKind FIGHTER_KINDS[FIGHTER_TYPE_COUNT] = {
+    {"Воин___", 100, 10, 5, 2, 1,
+     [](ostream& os, const string& attacker, int attackerTeam, const string& target, int targetTeam, int damage) {
+         os << attacker << " (Команда " << attackerTeam << ") наносит урон: " << damage << " на "
+            << target << " (Команда " << targetTeam << ")\n";
+     }},
+    {"Лучник_", 80, 5, 8, 1, 5,
+     [](ostream& os, const string& attacker, int attackerTeam, const string& target, int targetTeam, int damage) {
+         os << attacker << " (Команда " << attackerTeam << ") стреляет в " << target
+            << " (Команда " << targetTeam << ") и наносит " << damage << " урона.\n";
+     }},
+    {"Маг____", 60, 3, 10, 1, 3,
+     [](ostream& os, const string& attacker, int attackerTeam, const string& target, int targetTeam, int damage) {
+         os << attacker << " (Команда " << attackerTeam << ") колдует на " << target
+            << " (Команда " << targetTeam << ") и наносит " << damage << " урона.\n";
+     }},
+};
 
-    void receiveDamage(int damage) {
-        healthPoints -= damage;
-        if (healthPoints <= 0) {
-            healthPoints = 0;
-            isFighterAlive = false;
+/*
+ * Хранилище бойцов по столбцам (struct-of-arrays): боец - номер строки,
+ * его свойства лежат в непрерывных массивах, живость - в битовой маске.
+ * Раунд обходит массивы номеров без виртуальных вызовов и объектов в куче.
+ */
+class FighterStore {
+public:
+    vector<int> health;       // Текущее здоровье
+    vector<int> armor;        // Броня
+    vector<int> bonusDamage;  // Бонусный урон
+    vector<int> initiative;   // Инициатива
+    vector<int> teamID;       // Номер команды
+    vector<uint8_t> type;     // Вид бойца (FighterType)
+    vector<int> x, y;         // Позиция на поле
+    vector<int> number;       // Номер в команде (для имени)
+
+    // Резервирует место под count бойцов (столбцы не перераспределяются при добавлении)
+    void reserve(size_t count) {
+        health.reserve(count);
+        armor.reserve(count);
+        bonusDamage.reserve(count);
+        initiative.reserve(count);
+        teamID.reserve(count);
+        type.reserve(count);
+        x.reserve(count);
+        y.reserve(count);
+        number.reserve(count);
+        aliveBits.reserve((count + 63) / 64);
+    }
+
+    int add(FighterType kind, int team, int fighterInitiative, int fighterNumber, int xPos, int yPos) {
+        const FighterKind& info = FIGHTER_KINDS[kind];
+        int id = static_cast<int>(health.size());
+        health.push_back(info.health);
+        armor.push_back(info.armor);
+        bonusDamage.push_back(info.bonusDamage);
+        initiative.push_back(fighterInitiative);
+        teamID.push_back(team);
+        type.push_back(kind);
+        x.push_back(xPos);
+        y.push_back(yPos);
+        number.push_back(fighterNumber);
+        if (id % 64 == 0) {
+            aliveBits.push_back(0);
         }
+        aliveBits[id / 64] |= 1ULL << (id % 64);
+        return id;
     }
 
-    const string& getName() const { return fighterName; }
-    int getTeamID() const { return teamID; }
-    int getArmor() const { return defenseArmor; }
-    int getHealth() const { return healthPoints; }
-    int getX() const { return posX; }
-    int getY() const { return posY; }
-    int getInitiative() const { return attackSpeed; }
+    size_t size() const { return health.size(); }
 
-    void setPosition(int xPos, int yPos) {
-        posX = xPos;
-        posY = yPos;
+    bool alive(int id) const {
+        return (aliveBits[id / 64] >> (id % 64)) & 1;
     }
 
-    friend ostream& operator<<(ostream& os, const Fighter& fighter) {
-        os << left << setw(15) << fighter.fighterName
-           << left << setw(10) << fighter.teamID
-           << left << setw(10) << fighter.healthPoints
-           << left << setw(10) << fighter.defenseArmor
-           << left << setw(10) << fighter.extraDamage
-           << left << setw(10) << fighter.attackSpeed
-           << (fighter.isFighterAlive ? "Да" : "Нет");
-        return os;
+    void markDead(int id) {
+        aliveBits[id / 64] &= ~(1ULL << (id % 64));
     }
+
+    string name(int id) const {
+        return FIGHTER_KINDS[type[id]].namePrefix + to_string(number[id]);
+    }
+
+    // Строка таблицы команды
+    void printRow(ostream& os, int id) const {
+        os << left << setw(15) << name(id)
+           << left << setw(10) << teamID[id]
+           << left << setw(10) << health[id]
+           << left << setw(10) << armor[id]
+           << left << setw(10) << bonusDamage[id]
+           << left << setw(10) << initiative[id]
+           << (alive(id) ? "Да" : "Нет");
+    }
+
+private:
+    vector<uint64_t> aliveBits; // Бит id - боец жив
+};
+
+// Виды событий боя
+enum class BattleEventType : uint8_t {
+    RoundStart, // Начало раунда (target - номер раунда)
+    Move,       // Боец переместился в (x, y)
+    Attack,     // Боец нанес урон damage цели, у цели осталось health
+    RoundEnd,   // Конец раунда
+    Victory     // Победила сторона side (0 - ничья)
+};
+
+// Компактная двоичная запись события боя (28 байт)
+struct BattleEvent {
+    BattleEventType type;
+    uint8_t side;       // Сторона действующего бойца: 1 - первая команда боя, 2 - вторая
+    uint16_t damage;    // Урон атаки
+    int8_t dx, dy;      // Смещение перемещения (не больше MAX_FIGHTER_SPEED по каждой оси)
+    int32_t actor;      // Номер бойца в хранилище боя
+    int32_t target;     // Номер цели в хранилище боя или номер раунда
+    int32_t x, y;       // Позиция после перемещения
+    int32_t health;     // Здоровье цели после атаки
+};
+
+// Порядок хода в раунде
+enum class TurnOrder {
+    TeamByTeam,  // Сначала вся первая сторона, затем вся вторая (каждая - по инициативе)
+    Interleaved  // Бойцы обеих сторон вперемешку по инициативе
 };
 
 /*
-     * Конструктор для создания воина.
-     *
-     * @param name Имя воина.
-     * @param health Здоровье воина.
-     * @param armor Броня воина.
-     * @param damage Бонусный урон.
-     * @param speed Инициатива воина.
-     * @param team Номер команды.
-     * @param xPos Позиция по оси X.
-     * @param yPos Позиция по оси Y.
-     */
-class Warrior : public Fighter {
+ * Очередь хода: бойцы, упорядоченные по инициативе один раз в начале боя,
+ * в двусвязных списках на массивах next/prev, индексированных номером бойца.
+ * Погибший вычеркивается за O(1), поэтому раунд обходит только живых
+ * и ничего не сортирует.
+ */
+class TurnQueue {
 public:
-    Warrior(string name, int health, int armor, int bonusDamage, int initiative, int teamNum, int xPos, int yPos)
-        : Fighter(name, health, armor, bonusDamage, initiative, teamNum, xPos, yPos) {}
+    static constexpr int NONE = -1;
 
-    void attack(Fighter& enemy) override {
-        if (!enemy.alive()) return;
-        int damage = max(1, (rand() % 20 + 1) + extraDamage - enemy.getArmor());
-        cout << fighterName << " (Команда " << teamID << ") наносит урон: " << damage << " на "
-             << enemy.getName() << " (Команда " << enemy.getTeamID() << ")\n";
-        enemy.receiveDamage(damage);
-        cout << enemy.getName() << " (Команда " << enemy.getTeamID() << ") осталось здоровья: "
-             << enemy.getHealth() << "\n";
+    void reset(size_t fighterCount) {
+        next.assign(fighterCount, NONE);
+        prev.assign(fighterCount, NONE);
+        listOf.assign(fighterCount, 0);
+        heads.clear();
     }
 
-    void move(int targetX, int targetY) override {
-        setPosition(targetX, targetY);
-        cout << fighterName << " движется к врагу.\n";
+    // Добавляет список из бойцов ids (в порядке хода), возвращает его номер
+    int addList(const vector<int>& ids) {
+        int list = static_cast<int>(heads.size());
+        int previous = NONE;
+        for (int id : ids) {
+            prev[id] = previous;
+            listOf[id] = static_cast<uint8_t>(list);
+            if (previous != NONE) {
+                next[previous] = id;
+            }
+            previous = id;
+        }
+        heads.push_back(ids.empty() ? NONE : ids.front());
+        return list;
     }
+
+    int lists() const { return static_cast<int>(heads.size()); }
+    int first(int list) const { return heads[list]; }
+    int after(int id) const { return next[id]; }
+
+    void remove(int id) {
+        if (prev[id] != NONE) {
+            next[prev[id]] = next[id];
+        } else {
+            heads[listOf[id]] = next[id];
+        }
+        if (next[id] != NONE) {
+            prev[next[id]] = prev[id];
+        }
+    }
+
+private:
+    vector<int> next, prev;
+    vector<uint8_t> listOf; // Список, в котором стоит боец
+    vector<int> heads;      // Первый боец каждого списка
 };
-class Archer : public Fighter {
+
+/*
+ * Поле боя: прямоугольник width x height клеток, в клетке - не больше
+ * одного живого бойца (номер бойца или EMPTY). Поле - плотный
+ * пространственный индекс: враг в пределах дальности атаки ищется
+ * просмотром клеток вокруг бойца.
+ */
+struct Battlefield {
+    static constexpr int EMPTY = -1;
+
+    int width = 0;
+    int height = 0;
+    vector<int> occupant;
+
+    void resize(int fieldWidth, int fieldHeight) {
+        width = fieldWidth;
+        height = fieldHeight;
+        occupant.assign(static_cast<size_t>(width) * height, EMPTY);
+    }
+
+    int cell(int x, int y) const { return y * width + x; }
+    bool inside(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    bool isFree(int x, int y) const { return inside(x, y) && occupant[cell(x, y)] == EMPTY; }
+};
+
+/*
+ * Состояние боя двух сторон: поле, общее хранилище бойцов, для каждой стороны -
+ * ее бойцы и число живых, общая очередь хода.
+ */
+struct Battle {
+    Battlefield field;
+    FighterStore fighters;
+    vector<uint8_t> side;     // Сторона бойца (0 или 1)
+    vector<int> order[2];     // Бойцы стороны; после prepareTurns - по убыванию инициативы
+    int aliveCount[2] = {0, 0}; // Живые бойцы стороны
+    TurnOrder turnOrder = TurnOrder::TeamByTeam;
+    TurnQueue turns;          // Живые бойцы в порядке хода
+
+    // Ставит бойца в свободную клетку (x, y)
+    int addFighter(int fighterSide, FighterType kind, int team, int fighterInitiative, int x, int y) {
+        int number = static_cast<int>(order[fighterSide].size()) + 1;
+        int id = fighters.add(kind, team, fighterInitiative, number, x, y);
+        field.occupant[field.cell(x, y)] = id;
+        side.push_back(static_cast<uint8_t>(fighterSide));
+        order[fighterSide].push_back(id);
+        ++aliveCount[fighterSide];
+        return id;
+    }
+
     /*
-     * Конструктор для создания лучника.
-     *
-     * @param name Имя лучника.
-     * @param health Здоровье лучника.
-     * @param armor Броня лучника.
-     * @param damage Бонусный урон.
-     * @param speed Инициатива лучника.
-     * @param team Номер команды.
-     * @param xPos Позиция по оси X.
-     * @param yPos Позиция по оси Y.
+     * Строит очередь хода. Инициатива в бою не меняется, поэтому бойцы
+     * сортируются один раз (при равной инициативе - в порядке создания,
+     * первая сторона раньше второй).
      */
-public:
-    Archer(string name, int health, int armor, int bonusDamage, int initiative, int teamNum, int xPos, int yPos)
-        : Fighter(name, health, armor, bonusDamage, initiative, teamNum, xPos, yPos) {}
+    void prepareTurns() {
+        const vector<int>& speed = fighters.initiative;
+        auto faster = [&speed](int a, int b) { return speed[a] > speed[b]; };
+        stable_sort(order[0].begin(), order[0].end(), faster);
+        stable_sort(order[1].begin(), order[1].end(), faster);
 
-    void attack(Fighter& enemy) override {
-        if (!enemy.alive()) return;
-        int damage = max(1, (rand() % 20 + 1) + extraDamage - enemy.getArmor());
-        cout << fighterName << " (Команда " << teamID << ") стреляет в " << enemy.getName()
-             << " (Команда " << enemy.getTeamID() << ") и наносит " << damage << " урона.\n";
-        enemy.receiveDamage(damage);
-        cout << enemy.getName() << " (Команда " << enemy.getTeamID() << ") осталось здоровья: "
-             << enemy.getHealth() << "\n";
+        turns.reset(fighters.size());
+        if (turnOrder == TurnOrder::TeamByTeam) {
+            turns.addList(order[0]);
+            turns.addList(order[1]);
+        } else {
+            vector<int> merged(order[0].size() + order[1].size());
+            merge(order[0].begin(), order[0].end(), order[1].begin(), order[1].end(), merged.begin(), faster);
+            turns.addList(merged);
+        }
     }
 
-    void move(int targetX, int targetY) override {
-        setPosition(targetX, targetY);
-        cout << fighterName << " движется к врагу.\n";
+    bool hasAliveFighters(int side) const {
+        return aliveCount[side] > 0;
     }
-};
 
-class Mage : public Fighter {
-public:
-/*
-     * Конструктор для создания мага.
+    /*
+     * Ближайший живой боец стороны enemySide к бойцу id не дальше maxDistance
+     * (-1, если такого нет). Клетки просматриваются ромбами |dx| + |dy| = d
+     * с d = 1, 2, ..., поэтому первый найденный враг - ближайший. Из равноудаленных
+     * выбирается первый по порядку обхода, и у стороны 1 обход зеркален по x
+     * (см. mirrorX): иначе обе стороны предпочитали бы одно направление, и бой
+     * одинаковых команд был бы не в пользу стороны 0.
+     */
+    int findNearestEnemy(int id, int enemySide, int maxDistance) const {
+        int x = fighters.x[id];
+        int y = fighters.y[id];
+        int mirror = mirrorX(side[id]);
+        for (int distance = 1; distance <= maxDistance; ++distance) {
+            for (int dx = -distance; dx <= distance; ++dx) {
+                int dy = distance - abs(dx);
+                int found = enemyAt(x + mirror * dx, y + dy, enemySide);
+                if (found < 0 && dy != 0) {
+                    found = enemyAt(x + mirror * dx, y - dy, enemySide);
+                }
+                if (found >= 0) {
+                    return found;
+                }
+            }
+        }
+        return -1;
+    }
+
+    // Направление оси x для стороны: стороны расставлены зеркально (0 - слева, 1 - справа, см. createTeam)
+    static int mirrorX(int fighterSide) {
+        return fighterSide == 0 ? 1 : -1;
+    }
+
+    // Боец стороны enemySide в клетке (x, y) (-1, если его там нет)
+    int enemyAt(int x, int y, int enemySide) const {
+        if (!field.inside(x, y)) {
+            return -1;
+        }
+        int id = field.occupant[field.cell(x, y)];
+        return id != Battlefield::EMPTY && side[id] == enemySide ? id : -1;
+    }
+
+    // Переносит бойца в свободную клетку (targetX, targetY)
+    void moveFighter(int id, int targetX, int targetY) {
+        field.occupant[field.cell(fighters.x[id], fighters.y[id])] = Battlefield::EMPTY;
+        field.occupant[field.cell(targetX, targetY)] = id;
+        fighters.x[id] = targetX;
+        fighters.y[id] = targetY;
+    }
+
+    /*
+     * Атака бойца attacker по цели target стороны targetSide.
      *
-     * @param name Имя мага.
-     * @param health Здоровье мага.
-     * @param armor Броня мага.
-     * @param damage Бонусный урон.
-     * @param speed Инициатива мага.
-     * @param team Номер команды.
-     * @param xPos Позиция по оси X.
-     * @param yPos Позиция по оси Y.
+     * @param rng Генератор случайных чисел боя.
+     * @return Нанесенный урон (0, если цель уже мертва).
      */
-    Mage(string name, int health, int armor, int bonusDamage, int initiative, int teamNum, int xPos, int yPos)
-        : Fighter(name, health, armor, bonusDamage, initiative, teamNum, xPos, yPos) {}
+    int attack(int attacker, int target, int targetSide, BattleRng& rng) {
+        if (!fighters.alive(target)) return 0;
+        int damage = max(1, rollDie(rng, 20) + fighters.bonusDamage[attacker] - fighters.armor[target]);
+        fighters.health[target] -= damage;
+        if (fighters.health[target] <= 0) {
+            kill(target, targetSide);
+        }
+        return damage;
+    }
 
-    void attack(Fighter& enemy) override {
-        if (!enemy.alive()) return;
-        int damage = max(1, (rand() % 20 + 1) + extraDamage - enemy.getArmor());
-        cout << fighterName << " (Команда " << teamID << ") колдует на " << enemy.getName()
-             << " (Команда " << enemy.getTeamID() << ") и наносит " << damage << " урона.\n";
-        enemy.receiveDamage(damage);
-        cout << enemy.getName() << " (Команда " << enemy.getTeamID() << ") осталось здоровья: "
-             << enemy.getHealth() << "\n";
+    // Гибель бойца: он освобождает клетку и уходит из счета живых своей стороны и из очереди хода
+    void kill(int id, int fighterSide) {
+        field.occupant[field.cell(fighters.x[id], fighters.y[id])] = Battlefield::EMPTY;
+        fighters.health[id] = 0;
+        fighters.markDead(id);
+        --aliveCount[fighterSide];
+        turns.remove(id);
     }
 
-    void move(int targetX, int targetY) override {
-        setPosition(targetX, targetY);
-        cout << fighterName << " движется к врагу.\n";
+    // Повторяет над боем изменение, о котором сообщает событие (для воспроизведения записи)
+    void applyEvent(const BattleEvent& event) {
+        if (event.type == BattleEventType::Move) {
+            moveFighter(event.actor, event.x, event.y);
+        } else if (event.type == BattleEventType::Attack && fighters.alive(event.target)) {
+            fighters.health[event.target] = event.health;
+            if (event.health == 0) {
+                kill(event.target, side[event.target]);
+            }
+        }
+    }
+
+    void displayFighters(int displayedSide, ostream& os = cout) const {
+        os << left << setw(15) << "Имя"
+           << left << setw(10) << "Команда"
+           << left << setw(10) << "Здоровье"
+           << left << setw(10) << "Броня"
+           << left << setw(10) << "Бонус"
+           << left << setw(10) << "Инициатива"
+           << "Жив" << endl;
+
+        os << string(75, '-') << endl;
+
+        for (int id : order[displayedSide]) {
+            fighters.printRow(os, id);
+            os << endl;
+        }
+
+        os << string(75, '-') << endl;
     }
 };
 
-class Team {
+/*
+ * Поле потока к врагам одной стороны: число шагов (по четырем направлениям)
+ * от каждой клетки до ближайшего живого врага. Строится раз за раунд на сторону
+ * (при ее первом ходе): бойцы спускаются по нему к ближайшему врагу, не ища путь
+ * каждый сам, и по нему же видно, кому из них стоит искать цель рядом. Занятые
+ * клетки препятствием не считаются, их обходят при шаге (stepDownhill).
+ *
+ * Без препятствий поиск в ширину сразу из всех врагов дает манхэттенское
+ * расстояние до ближайшего, поэтому поле считается тем же результатом, но
+ * двумя последовательными проходами по строкам (прямым: сверху и слева,
+ * обратным: снизу и справа) - без очереди и с предсказуемым доступом к памяти.
+ */
+class FlowField {
+public:
+    static constexpr int UNREACHED = INT_MAX / 2; // Врагов нет (с запасом на +1)
+
+    bool ready() const { return isReady; }
+    void invalidate() { isReady = false; }
+    int at(int x, int y) const { return distance[static_cast<size_t>(y) * width + x]; }
+
+    void build(const Battle& battle, int side) {
+        width = battle.field.width;
+        int height = battle.field.height;
+        distance.assign(static_cast<size_t>(width) * height, UNREACHED);
+        const FighterStore& fighters = battle.fighters;
+        for (int id : battle.order[1 - side]) {
+            if (fighters.alive(id)) {
+                distance[static_cast<size_t>(fighters.y[id]) * width + fighters.x[id]] = 0;
+            }
+        }
+
+        for (int y = 0; y < height; ++y) {
+            int* row = distance.data() + static_cast<size_t>(y) * width;
+            if (y > 0) {
+                const int* above = row - width;
+                for (int x = 0; x < width; ++x) {
+                    row[x] = min(row[x], above[x] + 1);
+                }
+            }
+            for (int x = 1; x < width; ++x) {
+                row[x] = min(row[x], row[x - 1] + 1);
+            }
+        }
+        for (int y = height - 1; y >= 0; --y) {
+            int* row = distance.data() + static_cast<size_t>(y) * width;
+            if (y + 1 < height) {
+                const int* below = row + width;
+                for (int x = 0; x < width; ++x) {
+                    row[x] = min(row[x], below[x] + 1);
+                }
+            }
+            for (int x = width - 2; x >= 0; --x) {
+                row[x] = min(row[x], row[x + 1] + 1);
+            }
+        }
+        isReady = true;
+    }
+
 private:
-    vector<unique_ptr<Fighter>> teamFighters; // Список бойцов в команде
+    int width = 0;
+    vector<int> distance; // width x height по строкам
+    bool isReady = false;
+};
+
+/*
+ * Получатель событий боя. Бой сообщает о каждом действии только событием;
+ * без получателя (nullptr) события отбрасываются, и бой не тратит время
+ * на форматирование и вывод.
+ */
+class BattleEventSink {
+public:
+    virtual ~BattleEventSink() {}
+    virtual void onEvent(const BattleEvent& event) = 0;
+};
 
+// Запись событий в буфер для последующей обработки
+class BattleEventBuffer : public BattleEventSink {
 public:
-    void addFighter(unique_ptr<Fighter> fighter) {
-        teamFighters.push_back(move(fighter));
+    void onEvent(const BattleEvent& event) override {
+        events.push_back(event);
     }
 
-    vector<unique_ptr<Fighter>>& getFighters() {
-        return teamFighters;
-    }
+    const vector<BattleEvent>& getEvents() const { return events; }
+    void clear() { events.clear(); }
+
+private:
+    vector<BattleEvent> events;
+};
 
-    bool hasAliveFighters() const {
-        return any_of(teamFighters.begin(), teamFighters.end(), [](const unique_ptr<Fighter>& fighter) {
-            return fighter->alive();
-        });
+// Итог боя: победившая сторона winner или ничья (winner == 0)
+void printOutcome(ostream& os, int winner) {
+    if (winner == 0) {
+        os << "Ничья: бой остановлен, никто не атаковал слишком долго.\n";
+    } else {
+        os << "Команда " << winner << " победила!\n";
     }
+}
 
-    Fighter* findNearestEnemy(Fighter& fighter) {
-        Fighter* closestEnemy = nullptr;
-        int minimumDistance = INT_MAX;
+/*
+ * Вывод боя в консоль по событиям (прежний текстовый режим). Таблицы команд
+ * печатаются в начале раунда из текущего состояния, поэтому отрисовщик
+ * подключается к бою напрямую, а не к сохраненному буферу.
+ */
+class ConsoleRenderer : public BattleEventSink {
+public:
+    ConsoleRenderer(const Battle& battle, ostream& out = cout) : battle(battle), out(out) {}
 
-        for (const auto& enemy : teamFighters) {
-            if (enemy->alive()) {
-                int distance = calculateDistance(fighter, *enemy);
-                if (distance < minimumDistance) {
-                    minimumDistance = distance;
-                    closestEnemy = enemy.get();
-                }
+    void onEvent(const BattleEvent& event) override {
+        const FighterStore& fighters = battle.fighters;
+        switch (event.type) {
+            case BattleEventType::RoundStart:
+                out << "\n--- Бой ---\n";
+                battle.displayFighters(0, out);
+                battle.displayFighters(1, out);
+                break;
+            case BattleEventType::Move:
+                out << fighters.name(event.actor) << " движется к врагу.\n";
+                break;
+            case BattleEventType::Attack: {
+                string target = fighters.name(event.target);
+                FIGHTER_KINDS[fighters.type[event.actor]].printAttack(out, fighters.name(event.actor),
+                    fighters.teamID[event.actor], target, fighters.teamID[event.target], event.damage);
+                out << target << " (Команда " << fighters.teamID[event.target] << ") осталось здоровья: "
+                    << event.health << "\n";
+                break;
             }
+            case BattleEventType::RoundEnd:
+                out << "\n\n--- Следующий раунд ---\n\n";
+                break;
+            case BattleEventType::Victory:
+                printOutcome(out, event.side);
+                break;
         }
+    }
 
-        return closestEnemy;
+private:
+    const Battle& battle;
+    ostream& out;
+};
+
+/*
+ * Функция для создания команды бойцов указанного размера. Бойцы расставляются
+ * в случайные свободные клетки своей трети поля: первая сторона - левой,
+ * вторая - правой (поле должно вмещать команду, см. createBattle).
+ *
+ * @param battle Бой, в который добавляется команда.
+ * @param side Сторона команды в бою (0 или 1).
+ * @param teamSize Размер команды.
+ * @param teamID Номер команды.
+ */
+void createTeam(Battle& battle, int side, int teamSize, int teamID, BattleRng& rng) {
+    battle.fighters.reserve(battle.fighters.size() + teamSize);
+    battle.order[side].reserve(teamSize);
+    const Battlefield& field = battle.field;
+    int zoneWidth = max(1, field.width / 3);
+    int zoneX = side == 0 ? 0 : field.width - zoneWidth;
+    for (int i = 0; i < teamSize; ++i) {
+        FighterType kind = static_cast<FighterType>(rollDie(rng, 3) - 1);
+        int fighterInitiative = rollDie(rng, 20);
+        int x, y;
+        do {
+            x = zoneX + rollDie(rng, zoneWidth) - 1;
+            y = rollDie(rng, field.height) - 1;
+        } while (!field.isFree(x, y));
+        battle.addFighter(side, kind, teamID, fighterInitiative, x, y);
     }
+}
+
+/*
+ * Смещения перемещения за ход: боец делает до MAX_FIGHTER_SPEED шагов
+ * по сторонам клетки, поэтому |dx| + |dy| <= 2 и смещений всего 12.
+ * В журнале смещение пишется номером в этой таблице.
+ */
+static_assert(MAX_FIGHTER_SPEED == 2, "Таблица смещений рассчитана на скорость 2");
+constexpr int STEP_COUNT = 12;
+constexpr int8_t STEP_DX[STEP_COUNT] = {-2, -1, -1, -1, 0, 0, 0, 0, 1, 1, 1, 2};
+constexpr int8_t STEP_DY[STEP_COUNT] = {0, -1, 0, 1, -2, -1, 1, 2, -1, 0, 1, 0};
 
-    static int calculateDistance(const Fighter& a, const Fighter& b) {
-        return abs(a.getX() - b.getX()) + abs(a.getY() - b.getY());
+// Номер смещения по (dx + 2) * 5 + (dy + 2)
+inline uint8_t stepIndex(int dx, int dy) {
+    static const uint8_t INDEX[25] = {
+        0, 0, 0, 0, 0,
+        0, 1, 2, 3, 0,
+        4, 5, 0, 6, 7,
+        0, 8, 9, 10, 0,
+        0, 0, 11, 0, 0};
+    return INDEX[(dx + 2) * 5 + (dy + 2)];
+}
+
+/*
+ * Запись событий боя в компактный двоичный журнал. Событие - байт
+ * (тип | сторона << 3) и поля в виде varint: перемещение - боец, атака - боец,
+ * цель и урон. У перемещения сторона занимает один бит, а в старших битах
+ * заголовка - номер смещения: (тип | (сторона - 1) << 3 | номер << 4), см. STEP_DX.
+ * Боец пишется разностью (zigzag) с предыдущим ходившим бойцом той же стороны
+ * в этом раунде: очередь хода упорядочена по инициативе, а при равной - по номеру,
+ * поэтому разность обычно занимает один байт. Номер раунда, координаты и здоровье
+ * цели не пишутся: они восстанавливаются при чтении из состояния боя.
+ * Записанные события передаются дальше получателю next (если он задан).
+ *
+ * Запись идет на каждом ходе, поэтому обычное перемещение (2 байта) пишется
+ * коротким путем onEvent, а остальные события - отдельной функцией append.
+ * Класс final: бой с регистратором вызывает onEvent напрямую (см. battleTeams),
+ * и короткий путь встраивается в цикл боя. Для серии боев один регистратор
+ * переиспользуется через reset, и буфер не перевыделяется.
+ */
+class ReplayRecorder final : public BattleEventSink {
+public:
+    explicit ReplayRecorder(BattleEventSink* next = nullptr) : next(next) {}
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    // Начинает новую запись (до начала следующего боя)
+    void reset() {
+        cursor = log.data();
     }
 
-    void sortByInitiative() {
-        sort(teamFighters.begin(), teamFighters.end(), [](const unique_ptr<Fighter>& a, const unique_ptr<Fighter>& b) {
-            return a->getInitiative() > b->getInitiative();
-        });
+    // Короткий путь - перемещение с однобайтовой разностью номера бойца (почти все события большого боя)
+    void onEvent(const BattleEvent& event) override {
+        uint32_t actorDelta = zigzag(event.actor - lastActor[event.side]);
+        if (event.type == BattleEventType::Move && actorDelta < 0x80 && cursor < fastLimit) {
+            cursor[0] = moveHeader(event);
+            cursor[1] = static_cast<uint8_t>(actorDelta);
+            cursor += 2;
+            lastActor[event.side] = event.actor;
+        } else {
+            append(event);
+        }
     }
 
-    void displayFighters() const {
-        cout << left << setw(15) << "Имя"
-             << left << setw(10) << "Команда"
-             << left << setw(10) << "Здоровье"
-             << left << setw(10) << "Броня"
-             << left << setw(10) << "Бонус"
-             << left << setw(10) << "Инициатива"
-             << "Жив" << endl;
+    // Журнал записанного боя
+    vector<uint8_t> takeLog() const {
+        return vector<uint8_t>(log.data(), static_cast<const uint8_t*>(cursor));
+    }
 
-        cout << string(75, '-') << endl;
+private:
+    static constexpr size_t MAX_EVENT_BYTES = 1 + 3 * 5; // Заголовок и три varint
+    vector<uint8_t> log;
+    uint8_t* cursor = nullptr;    // Конец записанного
+    uint8_t* fastLimit = nullptr; // Граница короткого пути onEvent (при next - начало буфера)
+    int32_t lastActor[3] = {0, 0, 0}; // Последний записанный боец стороны 1 и 2 в раунде
+    BattleEventSink* next;
 
-        for (const auto& fighter : teamFighters) {
-            cout << *fighter;
-            cout << endl;
+    // Запись любого события и передача его получателю next
+    void append(const BattleEvent& event) {
+        size_t used = static_cast<size_t>(cursor - log.data());
+        if (used + MAX_EVENT_BYTES > log.size()) {
+            log.resize(max<size_t>(256, log.size() * 2));
+            cursor = log.data() + used;
+            // С получателем next каждое событие идет сюда, чтобы короткий путь его не проверял
+            fastLimit = next ? log.data() : log.data() + log.size() - MAX_EVENT_BYTES;
         }
+        if (event.type == BattleEventType::Move || event.type == BattleEventType::Attack) {
+            bool isMove = event.type == BattleEventType::Move;
+            *cursor++ = isMove ? moveHeader(event) : header(event);
+            int32_t& last = lastActor[event.side];
+            uint32_t fields[3] = {
+                zigzag(event.actor - last),
+                static_cast<uint32_t>(event.target),
+                static_cast<uint32_t>(event.damage)};
+            last = event.actor;
+            for (size_t i = 0; i < (isMove ? 1u : 3u); ++i) {
+                uint32_t value = fields[i];
+                while (value >= 0x80) {
+                    *cursor++ = static_cast<uint8_t>(value | 0x80);
+                    value >>= 7;
+                }
+                *cursor++ = static_cast<uint8_t>(value);
+            }
+        } else {
+            *cursor++ = header(event);
+            if (event.type == BattleEventType::RoundStart) {
+                lastActor[1] = lastActor[2] = 0; // Раунд читается с начала без предыдущих
+            }
+        }
+        if (next) {
+            next->onEvent(event);
+        }
+    }
 
-        cout << string(75, '-') << endl;
+    static uint8_t header(const BattleEvent& event) {
+        return static_cast<uint8_t>(static_cast<uint8_t>(event.type) | (event.side << 3));
+    }
+
+    static uint8_t moveHeader(const BattleEvent& event) {
+        return static_cast<uint8_t>(static_cast<uint8_t>(BattleEventType::Move) | (event.side - 1) << 3 |
+                                    stepIndex(event.dx, event.dy) << 4);
+    }
+
+    static uint32_t zigzag(int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
     }
 };
 
-Team createTeam(int teamSize, int teamID) {
-    Team team;
-    for (int i = 0; i < teamSize; ++i) {
-        int fighterType = rand() % 3;
-        if (fighterType == 0) {
-            team.addFighter(unique_ptr<Warrior>(new Warrior("Воин___" + to_string(i + 1), 100, 10, 5, rand() % 20 + 1, teamID, 0, 0)));
-        } else if (fighterType == 1) {
-            team.addFighter(unique_ptr<Archer>(new Archer("Лучник_" + to_string(i + 1), 80, 5, 8, rand() % 20 + 1, teamID, 1, 1)));
+// Итог боя
+struct BattleResult {
+    int winner; // Победившая сторона (1 или 2; 0 - ничья)
+    int rounds; // Количество раундов
+};
+
+/*
+ * Шаги бойца id вниз по полю потока: до speed шагов в свободную соседнюю
+ * клетку, которая ближе к врагу, пока враг не окажется в пределах дальности атаки.
+ * Из равных клеток выбирается случайная: при постоянном порядке направлений бойцы,
+ * смещенные по обеим осям, шли бы навстречу друг другу вбок (поле потока строится
+ * в начале раунда) и менялись бы местами по x, не сближаясь, до конца боя.
+ *
+ * @return true, если боец сдвинулся.
+ */
+bool stepDownhill(Battle& battle, int id, const FlowField& flow, BattleRng& rng) {
+    static const int STEP_X[4] = {1, -1, 0, 0};
+    static const int STEP_Y[4] = {0, 0, 1, -1};
+    const Battlefield& field = battle.field;
+    const FighterKind& kind = FIGHTER_KINDS[battle.fighters.type[id]];
+    int x = battle.fighters.x[id];
+    int y = battle.fighters.y[id];
+    for (int step = 0; step < kind.speed && flow.at(x, y) > kind.range; ++step) {
+        int bestX = x, bestY = y;
+        int best = flow.at(x, y);
+        int ties = 0; // Число найденных клеток с расстоянием best
+        for (int direction = 0; direction < 4; ++direction) {
+            int nextX = x + STEP_X[direction];
+            int nextY = y + STEP_Y[direction];
+            if (!field.isFree(nextX, nextY) || flow.at(nextX, nextY) > best) {
+                continue;
+            }
+            if (flow.at(nextX, nextY) < best) {
+                ties = 0;
+                best = flow.at(nextX, nextY);
+            } else if (ties == 0) {
+                continue; // Клетка не ближе текущей
+            }
+            // Каждая из ties + 1 равных клеток остается выбранной с вероятностью 1 / (ties + 1)
+            if (++ties == 1 || rng() % static_cast<unsigned>(ties) == 0) {
+                bestX = nextX;
+                bestY = nextY;
+            }
+        }
+        if (bestX == x && bestY == y) {
+            break; // Все клетки ближе к врагу заняты
+        }
+        x = bestX;
+        y = bestY;
+    }
+    if (x == battle.fighters.x[id] && y == battle.fighters.y[id]) {
+        return false;
+    }
+    battle.moveFighter(id, x, y);
+    return true;
+}
+
+/*
+ * Ходы бойцов списка list очереди: каждый атакует ближайшего врага в пределах
+ * своей дальности, а если такого нет - идет к врагам по полю потока своей стороны
+ * (flows[side], строится при первом ходе стороны в раунде).
+ *
+ * @return Число атак.
+ */
+template <class Sink>
+int takeTurns(Battle& battle, int list, FlowField (&flows)[2], BattleRng& rng, Sink* sink) {
+    const FighterStore& fighters = battle.fighters;
+    int attacks = 0;
+    // Ходящий жив, поэтому следующий за ним берется после хода (погибшие уже вычеркнуты)
+    for (int id = battle.turns.first(list); id != TurnQueue::NONE; id = battle.turns.after(id)) {
+        int side = battle.side[id];
+        int enemySide = 1 - side;
+        int range = FIGHTER_KINDS[fighters.type[id]].range;
+        if (!flows[side].ready()) {
+            flows[side].build(battle, side);
+        }
+        // С построения поля враги подошли не больше чем на MAX_FIGHTER_SPEED клеток, поэтому
+        // далекому от врагов бойцу (а таких в большом бою большинство) искать цель незачем
+        int target = -1;
+        if (flows[side].at(fighters.x[id], fighters.y[id]) <= range + MAX_FIGHTER_SPEED) {
+            target = battle.findNearestEnemy(id, enemySide, range);
+        }
+        BattleEvent event = {};
+        event.side = static_cast<uint8_t>(side + 1);
+        event.actor = id;
+        if (target < 0) {
+            int fromX = fighters.x[id];
+            int fromY = fighters.y[id];
+            if (!stepDownhill(battle, id, flows[side], rng)) {
+                continue;
+            }
+            event.type = BattleEventType::Move;
+            event.x = fighters.x[id];
+            event.y = fighters.y[id];
+            event.dx = static_cast<int8_t>(event.x - fromX);
+            event.dy = static_cast<int8_t>(event.y - fromY);
         } else {
-            team.addFighter(unique_ptr<Mage>(new Mage("Маг____" + to_string(i + 1), 60, 3, 10, rand() % 20 + 1, teamID, 2, 2)));
+            ++attacks;
+            event.type = BattleEventType::Attack;
+            event.damage = static_cast<uint16_t>(battle.attack(id, target, enemySide, rng));
+            event.target = target;
+            event.health = fighters.health[target];
+        }
+        if (sink) {
+            sink->onEvent(event);
         }
     }
-    return team;
+    return attacks;
+}
+
+// Бой с получателем событий конкретного типа Sink (см. battleTeams)
+template <class Sink>
+BattleResult runBattle(Battle& battle, BattleRng& rng, Sink* sink) {
+    auto emit = [sink](BattleEventType type, uint8_t side, int32_t value) {
+        if (sink) {
+            BattleEvent event = {};
+            event.type = type;
+            event.side = side;
+            event.target = value;
+            sink->onEvent(event);
+        }
+    };
+    battle.prepareTurns();
+    FlowField flows[2]; // Поля потока сторон, строятся заново каждый раунд
+    // За width + height раундов стороны сходятся с любого места поля; если за столько
+    // раундов никто никого не атаковал, бой останавливается ничьей. Со случайным выбором
+    // среди равных клеток (см. stepDownhill) бойцы не зацикливаются, и это только
+    // страховка от бесконечного боя
+    const int MAX_QUIET_ROUNDS = battle.field.width + battle.field.height;
+    int round = 0;
+    int quietRounds = 0;
+    while (battle.hasAliveFighters(0) && battle.hasAliveFighters(1) && quietRounds < MAX_QUIET_ROUNDS) {
+        emit(BattleEventType::RoundStart, 0, ++round);
+        flows[0].invalidate();
+        flows[1].invalidate();
+        int attacks = 0;
+        for (int list = 0; list < battle.turns.lists(); ++list) {
+            attacks += takeTurns(battle, list, flows, rng, sink);
+        }
+        quietRounds = attacks > 0 ? 0 : quietRounds + 1;
+        emit(BattleEventType::RoundEnd, 0, round);
+    }
+
+    // Остановленный бой - ничья независимо от числа выживших
+    int winner = 0;
+    if (!battle.hasAliveFighters(0) || !battle.hasAliveFighters(1)) {
+        winner = battle.hasAliveFighters(0) ? 1 : 2;
+    }
+    emit(BattleEventType::Victory, static_cast<uint8_t>(winner), round);
+    return {winner, round};
 }
 
 /*
- * Функция для создания команды бойцов указанного размера.
+ * Бой двух сторон до полного уничтожения одной из них.
+ * Бой с записью (sink - ReplayRecorder) идет отдельным экземпляром
+ * runBattle, где запись события встраивается в цикл боя.
  *
- * @param teamSize Размер команды.
- * @param teamNum Номер команды.
- * @return Возвращает созданную команду.
+ * @param battle Бой (стороны заполнены createTeam).
+ * @param rng Генератор случайных чисел боя.
+ * @param sink Получатель событий (nullptr - бой без вывода).
+ * @return Победившая сторона и число раундов.
+ */
+BattleResult battleTeams(Battle& battle, BattleRng& rng, BattleEventSink* sink = nullptr) {
+    if (ReplayRecorder* recorder = dynamic_cast<ReplayRecorder*>(sink)) {
+        return runBattle(battle, rng, recorder);
+    }
+    return runBattle(battle, rng, sink);
+}
+
+/*
+ * Создает бой двух команд из генератора rng (составы зависят только от его состояния).
+ * Поле - квадрат, на котором бойцы занимают не больше четверти клеток.
+ *
+ * @param teamSize1 Размер первой команды.
+ * @param teamSize2 Размер второй команды.
+ * @param turnOrder Порядок хода.
+ */
+Battle createBattle(int teamSize1, int teamSize2, TurnOrder turnOrder, BattleRng& rng) {
+    const int MIN_FIELD_SIZE = 16;
+    Battle battle;
+    battle.turnOrder = turnOrder;
+    int fieldSize = max(MIN_FIELD_SIZE, static_cast<int>(ceil(sqrt(4.0 * (teamSize1 + teamSize2)))));
+    battle.field.resize(fieldSize, fieldSize);
+    createTeam(battle, 0, teamSize1, 1, rng);
+    createTeam(battle, 1, teamSize2, 2, rng);
+    return battle;
+}
+
+// Параметры, по которым бой воспроизводится заново
+struct ReplayHeader {
+    uint64_t seed = 1;
+    uint64_t stream = 0;
+    int32_t teamSize1 = 5;
+    int32_t teamSize2 = 5;
+    TurnOrder turnOrder = TurnOrder::TeamByTeam;
+};
+
+/*
+ * Чтение журнала ReplayRecorder. Пропущенные при записи поля события
+ * вычисляются из состояния боя state, поэтому прочитанное событие нужно
+ * применить к state (Battle::applyEvent) до чтения следующего.
  */
-void battleTeams(Team& team1, Team& team2) {
-    while (team1.hasAliveFighters() && team2.hasAliveFighters()) {
-        team1.sortByInitiative();
-        team2.sortByInitiative();
-
-        cout << "\n--- Бой ---\n";
-        team1.displayFighters();
-        team2.displayFighters();
-
-        for (auto& fighter : team1.getFighters()) {
-            if (fighter->alive()) {
-                Fighter* target = team2.findNearestEnemy(*fighter);
-                if (target) {
-                    int distance = Team::calculateDistance(*fighter, *target);
-                    if (distance > 1) {
-                        fighter->move(target->getX(), target->getY());
-                    } else {
-                        fighter->attack(*target);
-                    }
+class ReplayReader {
+public:
+    ReplayReader(const vector<uint8_t>& log, size_t offset = 0, int round = 0)
+        : log(log), position(offset), currentRound(round) {}
+
+    size_t offset() const { return position; }
+    int round() const { return currentRound; }
+
+    // Пропускает следующее событие, не восстанавливая его полей; возвращает его тип
+    BattleEventType skip() {
+        BattleEventType type = static_cast<BattleEventType>(log[position++] & 7);
+        if (type == BattleEventType::Move) {
+            getVarint();
+        } else if (type == BattleEventType::Attack) {
+            getVarint();
+            getVarint();
+            getVarint();
+        } else if (type == BattleEventType::RoundStart) {
+            ++currentRound;
+        }
+        return type;
+    }
+
+    // Читает следующее событие; false - журнал закончился
+    bool next(const Battle& state, BattleEvent& event) {
+        if (position >= log.size()) {
+            return false;
+        }
+        uint8_t head = log[position++];
+        event = BattleEvent();
+        event.type = static_cast<BattleEventType>(head & 7);
+        event.side = static_cast<uint8_t>(head >> 3);
+        const FighterStore& fighters = state.fighters;
+        switch (event.type) {
+            case BattleEventType::RoundStart:
+                event.target = ++currentRound;
+                lastActor[1] = lastActor[2] = 0;
+                break;
+            case BattleEventType::RoundEnd:
+            case BattleEventType::Victory:
+                event.target = currentRound;
+                break;
+            case BattleEventType::Move: {
+                // Сторона - один бит, выше - номер смещения (см. ReplayRecorder)
+                int step = head >> 4;
+                if (step >= STEP_COUNT) {
+                    throw runtime_error("Replay log is corrupted");
+                }
+                event.side = static_cast<uint8_t>(((head >> 3) & 1) + 1);
+                event.actor = actorId(state, event.side);
+                event.dx = STEP_DX[step];
+                event.dy = STEP_DY[step];
+                event.x = fighters.x[event.actor] + event.dx;
+                event.y = fighters.y[event.actor] + event.dy;
+                if (!state.field.isFree(event.x, event.y)) {
+                    throw runtime_error("Replay log is corrupted");
                 }
+                break;
+            }
+            case BattleEventType::Attack:
+                event.actor = actorId(state, event.side);
+                event.target = fighterId(state);
+                event.damage = static_cast<uint16_t>(getVarint());
+                event.health = max(0, fighters.health[event.target] - event.damage);
+                break;
+            default:
+                throw runtime_error("Replay log is corrupted");
+        }
+        return true;
+    }
+
+private:
+    const vector<uint8_t>& log;
+    size_t position;
+    int currentRound;
+    int32_t lastActor[3] = {0, 0, 0}; // Последний прочитанный боец стороны 1 и 2 в раунде
+
+    static int32_t unzigzag(uint32_t value) {
+        return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+    }
+
+    uint32_t getVarint() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (position >= log.size()) {
+                throw runtime_error("Replay log is truncated");
+            }
+            uint8_t byte = log[position++];
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw runtime_error("Replay log is corrupted");
+    }
+
+    // Ходивший боец: разность с предыдущим бойцом той же стороны в раунде (см. ReplayRecorder)
+    int actorId(const Battle& state, uint8_t side) {
+        if (side != 1 && side != 2) {
+            throw runtime_error("Replay log is corrupted");
+        }
+        int64_t id = static_cast<int64_t>(lastActor[side]) + unzigzag(getVarint());
+        if (id < 0 || id >= static_cast<int64_t>(state.fighters.size())) {
+            throw runtime_error("Replay log is corrupted");
+        }
+        lastActor[side] = static_cast<int32_t>(id);
+        return static_cast<int>(id);
+    }
+
+    int fighterId(const Battle& state) {
+        uint32_t id = getVarint();
+        if (id >= state.fighters.size()) {
+            throw runtime_error("Replay log is corrupted");
+        }
+        return static_cast<int>(id);
+    }
+};
+
+// Первое расхождение двух записей
+struct ReplayDiff {
+    bool identical = true;
+    int round = 0;           // Раунд, в котором записи разошлись
+    long long event = 0;     // Номер события от начала записи
+    bool hasLeft = false;    // В первой записи есть событие с этим номером
+    bool hasRight = false;   // Во второй записи есть событие с этим номером
+    BattleEvent left = {};
+    BattleEvent right = {};
+};
+
+/*
+ * Запись боя: параметры (зерно, размеры команд, порядок хода) и журнал событий.
+ * Перемотка к любому раунду не требует повторной симуляции: при загрузке журнал
+ * прочитывается один раз, запоминаются смещения начала раундов и каждые
+ * keyframeRounds раундов - копия состояния боя (ключевой кадр); состояние к
+ * раунду - ближайший кадр плюс не более keyframeRounds раундов событий.
+ * Кадр долгого боя на большом поле велик, поэтому кадров не больше MAX_KEYFRAMES
+ * (промежуток - KEYFRAME_ROUNDS раундов или больше).
+ */
+class Replay {
+public:
+    static constexpr int KEYFRAME_ROUNDS = 8;
+    static constexpr int MAX_KEYFRAMES = 32;
+
+    Replay(const ReplayHeader& header, vector<uint8_t> log) : header(header), log(move(log)) {
+        buildIndex();
+    }
+
+    /*
+     * Проводит бой по параметрам header и записывает его.
+     *
+     * @param sink Получатель событий боя (nullptr - бой без вывода).
+     */
+    static Replay record(const ReplayHeader& header, BattleEventSink* sink = nullptr) {
+        BattleRng rng(header.seed, header.stream);
+        Battle battle = createBattle(header.teamSize1, header.teamSize2, header.turnOrder, rng);
+        ReplayRecorder recorder(sink);
+        battleTeams(battle, rng, &recorder);
+        return Replay(header, recorder.takeLog());
+    }
+
+    const ReplayHeader& getHeader() const { return header; }
+    const vector<uint8_t>& getLog() const { return log; }
+    int rounds() const { return static_cast<int>(roundOffsets.size()) - 1; }
+    int winner() const { return winningSide; } // 0 - ничья или запись оборвана до итога
+
+    // Состояние боя перед раундом round (rounds() + 1 - конец боя)
+    Battle stateAt(int round) const {
+        round = max(1, min(round, rounds() + 1));
+        // Кадры ставятся в начале сыгранных раундов: если rounds() кратно keyframeRounds,
+        // кадра для конца боя (round == rounds() + 1) нет, и берется последний
+        int keyframe = min((round - 1) / keyframeRounds, static_cast<int>(keyframes.size()) - 1);
+        Battle state = keyframes[keyframe];
+        ReplayReader reader(log, roundOffsets[keyframe * keyframeRounds], keyframe * keyframeRounds);
+        BattleEvent event;
+        while (reader.offset() < roundOffsets[round - 1] && reader.next(state, event)) {
+            state.applyEvent(event);
+        }
+        return state;
+    }
+
+    /*
+     * Воспроизводит раунды с fromRound по toRound включительно (и итог боя,
+     * если toRound - последний раунд). state приводится к началу fromRound,
+     * каждое событие применяется к нему и затем передается sink.
+     */
+    void play(Battle& state, int fromRound, int toRound, BattleEventSink* sink) const {
+        state = stateAt(fromRound);
+        toRound = min(toRound, rounds());
+        int first = max(1, min(fromRound, rounds() + 1));
+        ReplayReader reader(log, roundOffsets[first - 1], first - 1);
+        size_t end = toRound == rounds() ? log.size() : roundOffsets[toRound];
+        BattleEvent event;
+        while (reader.offset() < end && reader.next(state, event)) {
+            state.applyEvent(event);
+            if (sink) {
+                sink->onEvent(event);
             }
         }
+    }
+
+    // Повторная симуляция по зерну совпадает с журналом
+    bool resimulate() const {
+        return record(header).log == log;
+    }
+
+    // Первое расхождение событий двух записей (события читаются каждое из своего боя)
+    static ReplayDiff diff(const Replay& first, const Replay& second) {
+        ReplayDiff result;
+        Battle leftState = first.keyframes.front();
+        Battle rightState = second.keyframes.front();
+        ReplayReader leftReader(first.log);
+        ReplayReader rightReader(second.log);
+        for (;; ++result.event) {
+            result.hasLeft = leftReader.next(leftState, result.left);
+            result.hasRight = rightReader.next(rightState, result.right);
+            if (!result.hasLeft && !result.hasRight) {
+                return result;
+            }
+            result.round = max(leftReader.round(), rightReader.round());
+            if (result.hasLeft != result.hasRight || !sameEvent(result.left, result.right)) {
+                result.identical = false;
+                return result;
+            }
+            leftState.applyEvent(result.left);
+            rightState.applyEvent(result.right);
+        }
+    }
+
+    /*
+     * Сохраняет запись в файл: "BRP1", версия, параметры, длина и байты журнала.
+     *
+     * @throw runtime_error Если файл не удалось записать.
+     */
+    void save(const string& path) const {
+        ofstream out(path, ios::binary);
+        if (!out) {
+            throw runtime_error("Cannot open replay for writing: " + path);
+        }
+        out.write(REPLAY_MAGIC, 4);
+        uint32_t version = REPLAY_VERSION;
+        uint8_t order = static_cast<uint8_t>(header.turnOrder);
+        uint64_t size = log.size();
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&header.seed), sizeof(header.seed));
+        out.write(reinterpret_cast<const char*>(&header.stream), sizeof(header.stream));
+        out.write(reinterpret_cast<const char*>(&header.teamSize1), sizeof(header.teamSize1));
+        out.write(reinterpret_cast<const char*>(&header.teamSize2), sizeof(header.teamSize2));
+        out.write(reinterpret_cast<const char*>(&order), sizeof(order));
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        out.write(reinterpret_cast<const char*>(log.data()), static_cast<streamsize>(log.size()));
+        if (!out) {
+            throw runtime_error("Failed to write replay: " + path);
+        }
+    }
 
-        for (auto& fighter : team2.getFighters()) {
-            if (fighter->alive()) {
-                Fighter* target = team1.findNearestEnemy(*fighter);
-                if (target) {
-                    int distance = Team::calculateDistance(*fighter, *target);
-                    if (distance > 1) {
-                        fighter->move(target->getX(), target->getY());
-                    } else {
-                        fighter->attack(*target);
-                    }
+    /*
+     * Загружает запись, сохраненную save.
+     *
+     * @throw runtime_error Если файл не открывается, не является записью боя или поврежден.
+     */
+    static Replay load(const string& path) {
+        ifstream in(path, ios::binary);
+        if (!in) {
+            throw runtime_error("Cannot open replay: " + path);
+        }
+        char magic[4] = {};
+        uint32_t version = 0;
+        in.read(magic, 4);
+        in.read(reinterpret_cast<char*>(&version), sizeof(version));
+        if (!in || string(magic, 4) != string(REPLAY_MAGIC, 4) || version != REPLAY_VERSION) {
+            throw runtime_error("Not a replay file: " + path);
+        }
+        ReplayHeader header;
+        uint8_t order = 0;
+        uint64_t size = 0;
+        in.read(reinterpret_cast<char*>(&header.seed), sizeof(header.seed));
+        in.read(reinterpret_cast<char*>(&header.stream), sizeof(header.stream));
+        in.read(reinterpret_cast<char*>(&header.teamSize1), sizeof(header.teamSize1));
+        in.read(reinterpret_cast<char*>(&header.teamSize2), sizeof(header.teamSize2));
+        in.read(reinterpret_cast<char*>(&order), sizeof(order));
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!in || order > 1) {
+            throw runtime_error("Replay is truncated: " + path);
+        }
+        if (header.teamSize1 < 0 || header.teamSize2 < 0 ||
+            header.teamSize1 > MAX_TEAM_SIZE || header.teamSize2 > MAX_TEAM_SIZE) {
+            throw runtime_error("Replay has invalid team sizes: " + path);
+        }
+        header.turnOrder = static_cast<TurnOrder>(order);
+        // Длина журнала сверяется с остатком файла до выделения памяти под него
+        streamoff logStart = in.tellg();
+        in.seekg(0, ios::end);
+        uint64_t available = static_cast<uint64_t>(in.tellg() - logStart);
+        in.seekg(logStart);
+        if (!in || size > available) {
+            throw runtime_error("Replay is truncated: " + path);
+        }
+        vector<uint8_t> log(static_cast<size_t>(size));
+        in.read(reinterpret_cast<char*>(log.data()), static_cast<streamsize>(size));
+        if (static_cast<uint64_t>(in.gcount()) != size) {
+            throw runtime_error("Replay is truncated: " + path);
+        }
+        return Replay(header, move(log));
+    }
+
+private:
+    static constexpr const char* REPLAY_MAGIC = "BRP1";
+    static constexpr uint32_t REPLAY_VERSION = 2;
+    static constexpr int32_t MAX_TEAM_SIZE = 1 << 20; // Больше не загружается: поле боя не поместится в память
+
+    ReplayHeader header;
+    vector<uint8_t> log;
+    vector<size_t> roundOffsets; // Начало раунда r - roundOffsets[r - 1], последний элемент - итог боя
+    vector<Battle> keyframes;    // Состояние перед раундом 1 + k * keyframeRounds
+    int keyframeRounds = KEYFRAME_ROUNDS;
+    int winningSide = 0;
+    bool finished = false; // В записи есть итог боя
+
+    void buildIndex() {
+        ReplayReader counter(log);
+        while (counter.offset() < log.size()) {
+            counter.skip();
+        }
+        keyframeRounds = max(KEYFRAME_ROUNDS, (counter.round() + MAX_KEYFRAMES - 1) / MAX_KEYFRAMES);
+
+        BattleRng rng(header.seed, header.stream);
+        Battle state = createBattle(header.teamSize1, header.teamSize2, header.turnOrder, rng);
+        state.prepareTurns();
+        keyframes.push_back(state);
+
+        ReplayReader reader(log);
+        size_t offset = 0;
+        BattleEvent event;
+        while (reader.next(state, event)) {
+            if (event.type == BattleEventType::RoundStart) {
+                roundOffsets.push_back(offset);
+                if (event.target > 1 && (event.target - 1) % keyframeRounds == 0) {
+                    keyframes.push_back(state);
                 }
+            } else if (event.type == BattleEventType::Victory) {
+                winningSide = event.side;
+                finished = true;
+                roundOffsets.push_back(offset);
             }
+            state.applyEvent(event);
+            offset = reader.offset();
+        }
+        if (!finished) {
+            roundOffsets.push_back(log.size()); // Запись оборвана до итога
         }
+    }
+
+    static bool sameEvent(const BattleEvent& a, const BattleEvent& b) {
+        return a.type == b.type && a.side == b.side && a.damage == b.damage && a.actor == b.actor &&
+               a.target == b.target && a.x == b.x && a.y == b.y && a.health == b.health;
+    }
+};
 
-        cout << "\n\n--- Следующий раунд ---\n\n";
+// Поля события для сравнения записей
+ostream& operator<<(ostream& os, const BattleEvent& event) {
+    static const char* const NAMES[] = {"начало раунда", "перемещение", "атака", "конец раунда", "победа"};
+    os << NAMES[static_cast<int>(event.type)] << ", сторона " << static_cast<int>(event.side);
+    if (event.type == BattleEventType::Move) {
+        os << ", боец " << event.actor << " -> (" << event.x << ", " << event.y << ")";
+    } else if (event.type == BattleEventType::Attack) {
+        os << ", боец " << event.actor << " -> " << event.target << ", урон " << event.damage
+           << ", осталось " << event.health;
     }
+    return os;
+}
 
-    if (team1.hasAliveFighters()) {
-        cout << "Команда 1 победила!\n";
-    } else {
-        cout << "Команда 2 победила!\n";
+// Параметры турнира
+struct TournamentSettings {
+    int teamSize1 = 5;               // Размер первой команды
+    int teamSize2 = 5;               // Размер второй команды
+    uint64_t seed = 1;               // Общее зерно: бой i получает генератор из (seed, i)
+    long long maxBattles = 1000000;  // Наибольшее число боев
+    int batchSize = 1000;            // Боев в блоке; правило остановки проверяется на границах блоков
+    double targetHalfWidth = 0;      // Остановиться, когда полуширина 95% интервала не больше (0 - не проверять)
+    bool stopWhenDecided = false;    // Остановиться, когда интервал не содержит 0.5
+    unsigned threads = 0;            // Потоков (0 - по числу ядер)
+    TurnOrder turnOrder = TurnOrder::TeamByTeam;
+};
+
+// Итоги турнира
+struct TournamentResult {
+    long long battles = 0;
+    long long wins1 = 0;             // Победы первой команды
+    long long draws = 0;             // Ничьи (бой остановлен при равном числе живых)
+    long long totalRounds = 0;
+    bool stoppedEarly = false;
+
+    // Доля побед первой команды среди боев с победителем
+    long long decided() const { return battles - draws; }
+    double winRate() const { return decided() > 0 ? static_cast<double>(wins1) / decided() : 0; }
+    double meanRounds() const { return battles > 0 ? static_cast<double>(totalRounds) / battles : 0; }
+
+    // 95% доверительный интервал Уилсона для доли побед первой команды
+    pair<double, double> confidenceInterval() const {
+        if (decided() == 0) {
+            return {0, 1};
+        }
+        const double z = 1.96;
+        double n = static_cast<double>(decided());
+        double p = winRate();
+        double denominator = 1 + z * z / n;
+        double center = (p + z * z / (2 * n)) / denominator;
+        double half = z * sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / denominator;
+        return {max(0.0, center - half), min(1.0, center + half)};
+    }
+};
+
+/*
+ * Турнир: множество независимых боев сторон, созданных createTeam, на всех ядрах.
+ * Бои идут блоками по batchSize; потоки разбирают блоки очередной волны
+ * (TOURNAMENT_WAVE блоков), затем блоки учитываются строго по порядку, и после
+ * каждого проверяется правило остановки. Поэтому итог, включая момент остановки,
+ * зависит только от зерна и параметров, но не от числа потоков.
+ * Повторные проверки правила немного завышают вероятность ошибки интервала.
+ *
+ * @param settings Параметры турнира.
+ * @return Итоги турнира.
+ */
+TournamentResult runTournament(const TournamentSettings& settings) {
+    const int TOURNAMENT_WAVE = 64;
+    unsigned threads = settings.threads ? settings.threads : max(1u, thread::hardware_concurrency());
+    long long batchSize = max(1, settings.batchSize);
+    long long batchCount = (settings.maxBattles + batchSize - 1) / batchSize;
+
+    struct BatchTotals {
+        long long battles = 0;
+        long long wins1 = 0;
+        long long draws = 0;
+        long long rounds = 0;
+    };
+    TournamentResult result;
+    vector<BatchTotals> wave;
+    for (long long firstBatch = 0; firstBatch < batchCount; firstBatch += TOURNAMENT_WAVE) {
+        long long waveBatches = min<long long>(TOURNAMENT_WAVE, batchCount - firstBatch);
+        wave.assign(static_cast<size_t>(waveBatches), BatchTotals());
+        atomic<long long> nextBatch(0);
+        auto worker = [&]() {
+            for (long long b = nextBatch++; b < waveBatches; b = nextBatch++) {
+                long long first = (firstBatch + b) * batchSize;
+                long long last = min(settings.maxBattles, first + batchSize);
+                BatchTotals& totals = wave[static_cast<size_t>(b)];
+                for (long long battle = first; battle < last; ++battle) {
+                    BattleRng rng(settings.seed, static_cast<uint64_t>(battle)); // Поток боя - его номер
+                    Battle fight = createBattle(settings.teamSize1, settings.teamSize2, settings.turnOrder, rng);
+                    BattleResult outcome = battleTeams(fight, rng);
+                    ++totals.battles;
+                    totals.wins1 += outcome.winner == 1;
+                    totals.draws += outcome.winner == 0;
+                    totals.rounds += outcome.rounds;
+                }
+            }
+        };
+        vector<thread> pool;
+        for (unsigned i = 0; i < min<long long>(threads, waveBatches); ++i) {
+            pool.emplace_back(worker);
+        }
+        for (auto& t : pool) {
+            t.join();
+        }
+
+        for (const BatchTotals& totals : wave) {
+            result.battles += totals.battles;
+            result.wins1 += totals.wins1;
+            result.draws += totals.draws;
+            result.totalRounds += totals.rounds;
+            pair<double, double> interval = result.confidenceInterval();
+            bool narrow = settings.targetHalfWidth > 0 &&
+                          (interval.second - interval.first) / 2 <= settings.targetHalfWidth;
+            bool decided = settings.stopWhenDecided && (interval.first > 0.5 || interval.second < 0.5);
+            if (narrow || decided) {
+                result.stoppedEarly = result.battles < settings.maxBattles;
+                return result;
+            }
+        }
     }
+    return result;
 }
 
-int main() {
-    srand(static_cast<unsigned>(time(0)));
+/*
+ * Параметры командной строки:
+ *   --headless - бой без вывода событий (печатается только итог);
+ *   --size <n> - размер каждой команды (по умолчанию 5);
+ *   --tournament <n> - турнир до n боев вместо одного боя;
+ *   --seed <n> - зерно (по умолчанию - текущее время);
+ *   --precision <h> - в турнире остановиться, когда полуширина интервала не больше h;
+ *   --interleaved - стороны ходят вперемешку по инициативе, а не по очереди;
+ *   --record <file> - сохранить запись боя в файл;
+ *   --replay <file> - проверить запись повторной симуляцией и воспроизвести ее;
+ *   --round <r> - воспроизводить запись с раунда r;
+ *   --diff <a> <b> - найти первое расхождение двух записей.
+ */
+int main(int argc, char* argv[]) {
+    bool headless = false;
+    int teamSize = 5;
+    long long tournamentBattles = 0;
+    uint64_t seed = static_cast<uint64_t>(time(0));
+    double precision = 0;
+    TurnOrder turnOrder = TurnOrder::TeamByTeam;
+    string recordPath, replayPath, diffLeft, diffRight;
+    int fromRound = 1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--size" && i + 1 < argc) {
+            teamSize = atoi(argv[++i]);
+        } else if (arg == "--tournament" && i + 1 < argc) {
+            tournamentBattles = atoll(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--precision" && i + 1 < argc) {
+            precision = atof(argv[++i]);
+        } else if (arg == "--interleaved") {
+            turnOrder = TurnOrder::Interleaved;
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--round" && i + 1 < argc) {
+            fromRound = atoi(argv[++i]);
+        } else if (arg == "--diff" && i + 2 < argc) {
+            diffLeft = argv[++i];
+            diffRight = argv[++i];
+        }
+    }
+
+    try {
+        if (!diffLeft.empty()) {
+            ReplayDiff difference = Replay::diff(Replay::load(diffLeft), Replay::load(diffRight));
+            if (difference.identical) {
+                cout << "Записи совпадают (событий: " << difference.event << ")\n";
+            } else {
+                cout << "Записи расходятся в раунде " << difference.round << ", событие "
+                     << difference.event << ":\n";
+                cout << "  " << diffLeft << ": ";
+                if (difference.hasLeft) cout << difference.left; else cout << "конец записи";
+                cout << "\n  " << diffRight << ": ";
+                if (difference.hasRight) cout << difference.right; else cout << "конец записи";
+                cout << "\n";
+            }
+            return 0;
+        }
+
+        if (!replayPath.empty()) {
+            Replay replay = Replay::load(replayPath);
+            cout << "Раундов: " << replay.rounds() << ", повторная симуляция "
+                 << (replay.resimulate() ? "совпадает с записью" : "расходится с записью") << "\n";
+            Battle state;
+            ConsoleRenderer renderer(state);
+            replay.play(state, fromRound, replay.rounds(), headless ? nullptr : &renderer);
+            if (headless) {
+                printOutcome(cout, replay.winner());
+            }
+            return 0;
+        }
+    } catch (const runtime_error& e) {
+        cerr << "Ошибка: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (tournamentBattles > 0) {
+        TournamentSettings settings;
+        settings.teamSize1 = settings.teamSize2 = teamSize;
+        settings.seed = seed;
+        settings.maxBattles = tournamentBattles;
+        settings.targetHalfWidth = precision;
+        settings.turnOrder = turnOrder;
+        TournamentResult result = runTournament(settings);
+        pair<double, double> interval = result.confidenceInterval();
+        cout << "Боев: " << result.battles << (result.stoppedEarly ? " (остановлено досрочно)" : "") << "\n";
+        cout << "Ничьих: " << result.draws << "\n";
+        cout << "Доля побед команды 1 (без ничьих): " << result.winRate() << " (95% интервал: " << interval.first
+             << " - " << interval.second << ")\n";
+        cout << "Среднее число раундов: " << result.meanRounds() << "\n";
+        return 0;
+    }
+
+    BattleRng rng(seed); // Инициализация генератора случайных чисел
 
     // Создаем две команды бойцов
-    Team team1 = createTeam(5, 1);
-    Team team2 = createTeam(5, 2);
+    Battle battle = createBattle(teamSize, teamSize, turnOrder, rng);
 
     // Запускаем бой между командами
-    battleTeams(team1, team2);
+    ConsoleRenderer renderer(battle);
+    BattleEventSink* sink = headless ? nullptr : &renderer;
+    ReplayRecorder recorder(sink);
+    if (!recordPath.empty()) {
+        sink = &recorder;
+    }
+    int winner = battleTeams(battle, rng, sink).winner;
+    if (headless) {
+        printOutcome(cout, winner);
+    }
+
+    if (!recordPath.empty()) {
+        ReplayHeader header;
+        header.seed = seed;
+        header.teamSize1 = header.teamSize2 = teamSize;
+        header.turnOrder = turnOrder;
+        try {
+            Replay(header, recorder.takeLog()).save(recordPath);
+        } catch (const runtime_error& e) {
+            cerr << "Ошибка: " << e.what() << "\n";
+            return 1;
+        }
+    }
 
     return 0;
 }
@@ -1,5 +1,12 @@
 #include <iostream>
 #include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
 
 /**
  * @brief Класс, представляющий очередь.
@@ -199,6 +206,650 @@ public:
     }
 };
 
+/// Размер строки кэша: индексы очередей разнесены по разным строкам.
+constexpr std::size_t CACHE_LINE = 64;
+
+/**
+ * @brief Округляет емкость кольцевой очереди вверх до степени двойки (не меньше 2).
+ */
+inline std::size_t roundCapacity(std::size_t size) {
+    std::size_t capacity = 2;
+    while (capacity < size) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/**
+ * @brief Очередь для одного производителя и одного потребителя без блокировок.
+ *
+ * Кольцевой буфер фиксированной емкости (степень двойки, индекс ячейки -
+ * младшие биты счетчика). Производитель пишет только tail, потребитель -
+ * только head; каждый индекс публикуется с memory_order_release и читается
+ * другой стороной с memory_order_acquire. Индексы лежат в разных строках кэша
+ * вместе с копией чужого индекса, которую сторона обновляет, только когда
+ * по копии очередь кажется полной (пустой), - так строка чужого индекса
+ * не пересылается между ядрами на каждой операции.
+ *
+ * enqueue/dequeue/peek/size работают как у Queue, но вызывать enqueue можно
+ * только из потока-производителя, а dequeue и peek - только из потока-потребителя.
+ *
+ * @tparam T Тип элементов (с конструктором по умолчанию и присваиванием).
+ */
+template <typename T>
+class SpscQueue {
+private:
+    /// Данные потребителя: позиция чтения и копия позиции записи.
+    struct alignas(CACHE_LINE) ConsumerSide {
+        std::atomic<std::size_t> head{0}; ///< Номер следующего элемента для чтения.
+        std::size_t cachedTail = 0;       ///< Последняя прочитанная позиция записи.
+    };
+
+    /// Данные производителя: позиция записи и копия позиции чтения.
+    struct alignas(CACHE_LINE) ProducerSide {
+        std::atomic<std::size_t> tail{0}; ///< Номер следующей свободной ячейки.
+        std::size_t cachedHead = 0;       ///< Последняя прочитанная позиция чтения.
+    };
+
+    ConsumerSide consumer;
+    ProducerSide producer;
+    std::size_t mask;  ///< Емкость - 1.
+    T* data;           ///< Ячейки буфера.
+
+public:
+    /**
+     * @brief Создает очередь емкостью не меньше size элементов.
+     *
+     * @param size Требуемая емкость (округляется вверх до степени двойки).
+     */
+    explicit SpscQueue(std::size_t size = 1024) : mask(roundCapacity(size) - 1) {
+        data = new T[mask + 1];
+    }
+
+    ~SpscQueue() {
+        delete[] data;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Добавляет элемент, если есть место (только поток-производитель).
+     *
+     * @param item Элемент для добавления.
+     * @return false Если очередь полна.
+     */
+    bool try_enqueue(const T& item) {
+        std::size_t tail = producer.tail.load(std::memory_order_relaxed);
+        if (tail - producer.cachedHead > mask) {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            if (tail - producer.cachedHead > mask) {
+                return false;
+            }
+        }
+        data[tail & mask] = item;
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Добавляет сколько поместится из count элементов одной публикацией.
+     *
+     * @param items Элементы для добавления.
+     * @param count Количество элементов.
+     * @return std::size_t Сколько элементов добавлено (с начала items).
+     */
+    std::size_t try_enqueue(const T* items, std::size_t count) {
+        std::size_t tail = producer.tail.load(std::memory_order_relaxed);
+        std::size_t free = mask + 1 - (tail - producer.cachedHead);
+        if (free < count) {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            free = mask + 1 - (tail - producer.cachedHead);
+        }
+        std::size_t n = count < free ? count : free;
+        for (std::size_t i = 0; i < n; ++i) {
+            data[(tail + i) & mask] = items[i];
+        }
+        if (n > 0) {
+            producer.tail.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    /**
+     * @brief Извлекает первый элемент, если он есть (только поток-потребитель).
+     *
+     * @param item Сюда записывается извлеченный элемент.
+     * @return false Если очередь пуста.
+     */
+    bool try_dequeue(T& item) {
+        std::size_t head = consumer.head.load(std::memory_order_relaxed);
+        if (head == consumer.cachedTail) {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            if (head == consumer.cachedTail) {
+                return false;
+            }
+        }
+        item = data[head & mask];
+        consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Извлекает до maxCount элементов одним освобождением ячеек.
+     *
+     * @param items Буфер для извлеченных элементов.
+     * @param maxCount Размер буфера.
+     * @return std::size_t Сколько элементов извлечено.
+     */
+    std::size_t try_dequeue(T* items, std::size_t maxCount) {
+        std::size_t head = consumer.head.load(std::memory_order_relaxed);
+        std::size_t available = consumer.cachedTail - head;
+        if (available < maxCount) {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            available = consumer.cachedTail - head;
+        }
+        std::size_t n = maxCount < available ? maxCount : available;
+        for (std::size_t i = 0; i < n; ++i) {
+            items[i] = data[(head + i) & mask];
+        }
+        if (n > 0) {
+            consumer.head.store(head + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    /**
+     * @brief Добавляет элемент в конец очереди (только поток-производитель).
+     *
+     * @param item Элемент для добавления.
+     * @throw std::overflow_error Если очередь полна.
+     */
+    void enqueue(const T& item) {
+        if (!try_enqueue(item)) {
+            throw std::overflow_error("Queue is full");
+        }
+    }
+
+    /**
+     * @brief Удаляет элемент из начала очереди (только поток-потребитель).
+     *
+     * @throw std::out_of_range Если очередь пуста.
+     */
+    void dequeue() {
+        T item;
+        if (!try_dequeue(item)) {
+            throw std::out_of_range("Queue is empty");
+        }
+    }
+
+    /**
+     * @brief Получает первый элемент, не удаляя его (только поток-потребитель).
+     *
+     * @return T Первый элемент в очереди.
+     * @throw std::out_of_range Если очередь пуста.
+     */
+    T peek() {
+        std::size_t head = consumer.head.load(std::memory_order_relaxed);
+        if (head == consumer.cachedTail) {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            if (head == consumer.cachedTail) {
+                throw std::out_of_range("Queue is empty");
+            }
+        }
+        return data[head & mask];
+    }
+
+    /**
+     * @brief Проверяет, пуста ли очередь (при работающих потоках - на момент вызова).
+     */
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Получает текущий размер очереди (при работающих потоках - приблизительный).
+     */
+    std::size_t size() const {
+        std::size_t head = consumer.head.load(std::memory_order_acquire);
+        std::size_t tail = producer.tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    /**
+     * @brief Получает емкость очереди.
+     */
+    std::size_t capacity() const {
+        return mask + 1;
+    }
+};
+
+/**
+ * @brief Замер пропускной способности SpscQueue между двумя потоками.
+ *
+ * Производитель передает числа 0..operations-1, потребитель проверяет порядок.
+ * Пропускная способность - переданные элементы в секунду.
+ *
+ * @param operations Количество передаваемых элементов.
+ * @param batch Размер пакета (1 - поэлементные try_enqueue/try_dequeue).
+ * @return double Миллионов элементов в секунду (0, если порядок нарушен).
+ */
+double benchmarkSpsc(long long operations, std::size_t batch) {
+    SpscQueue<long long> queue(1 << 14);
+    bool ordered = true;
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread consumerThread([&]() {
+        std::vector<long long> items(batch);
+        long long expected = 0;
+        while (expected < operations) {
+            std::size_t n = batch == 1 ? queue.try_dequeue(items[0]) : queue.try_dequeue(items.data(), batch);
+            if (n == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                ordered = ordered && items[i] == expected;
+                ++expected;
+            }
+        }
+    });
+
+    std::vector<long long> items(batch);
+    for (long long next = 0; next < operations;) {
+        std::size_t count = static_cast<std::size_t>(std::min<long long>(batch, operations - next));
+        for (std::size_t i = 0; i < count; ++i) {
+            items[i] = next + static_cast<long long>(i);
+        }
+        std::size_t sent = batch == 1 ? queue.try_enqueue(items[0]) : queue.try_enqueue(items.data(), count);
+        if (sent == 0) {
+            std::this_thread::yield();
+        }
+        next += static_cast<long long>(sent);
+    }
+    consumerThread.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return ordered ? operations / seconds / 1e6 : 0;
+}
+
+/**
+ * @brief Ограниченная очередь для многих производителей и потребителей.
+ *
+ * Кольцо ячеек с порядковыми номерами (схема Вьюкова): в ячейке хранится
+ * номер sequence, по которому поток понимает, свободна ли она для записи
+ * позиции pos (sequence == pos) или уже заполнена и ждет чтения
+ * (sequence == pos + 1). Производители занимают позиции CAS-ом по enqueuePos,
+ * потребители - по dequeuePos; общей блокировки нет, потоки конкурируют
+ * только за свой счетчик и за конкретную ячейку.
+ *
+ * try_enqueue/try_dequeue не блокируются. push/pop ждут места (элемента):
+ * сначала несколько раз повторяют попытку, затем засыпают на условной
+ * переменной. Будят их только если есть спящие (счетчик ждущих), так что
+ * быстрый путь не трогает мьютексы.
+ *
+ * @tparam T Тип элементов (с конструктором по умолчанию и присваиванием).
+ */
+template <typename T>
+class MpmcQueue {
+private:
+    /// Ячейка кольца.
+    struct Cell {
+        std::atomic<std::size_t> sequence; ///< Номер позиции, которую ждет ячейка.
+        T value;                           ///< Элемент.
+    };
+
+    /// Счетчик позиций в отдельной строке кэша.
+    struct alignas(CACHE_LINE) Position {
+        std::atomic<std::size_t> value{0};
+    };
+
+    /// Спящие потоки одной стороны очереди.
+    struct alignas(CACHE_LINE) Waiters {
+        std::atomic<int> count{0};          ///< Сколько потоков спит или собирается уснуть.
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    /// Сколько раз push/pop повторяют попытку, прежде чем уснуть.
+    static constexpr int SPIN_LIMIT = 64;
+    /// После стольких попыток поток уступает процессор между ними.
+    static constexpr int SPIN_BEFORE_YIELD = 16;
+
+    Cell* cells;
+    std::size_t mask;       ///< Емкость - 1.
+    Position enqueuePos;    ///< Следующая позиция для записи.
+    Position dequeuePos;    ///< Следующая позиция для чтения.
+    Waiters notEmpty;       ///< Потребители, ждущие элемента.
+    Waiters notFull;        ///< Производители, ждущие места.
+
+    /**
+     * @brief Будит один спящий поток стороны, если такие есть.
+     */
+    static void wakeOne(Waiters& waiters) {
+        // Пара к барьеру в waitUntil: либо мы увидим счетчик ждущего,
+        // либо он после увеличения счетчика увидит наш элемент.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.count.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(waiters.mutex);
+            waiters.condition.notify_one();
+        }
+    }
+
+    /**
+     * @brief Повторяет attempt, пока она не удастся или не наступит deadline.
+     *
+     * Попытка выполняется в том числе под мьютексом waiters, поэтому сама
+     * никого не будит: другую сторону (opposite) будим уже без блокировки,
+     * иначе производитель и потребитель захватывали бы мьютексы в разном порядке.
+     *
+     * @param attempt Неблокирующая попытка (tryEnqueue/tryDequeue).
+     * @param waiters На чьей условной переменной спать.
+     * @param opposite Кого будить после удачной попытки.
+     * @param deadline Крайний срок (nullptr - ждать без ограничения).
+     * @return true Если попытка удалась.
+     */
+    template <typename Attempt>
+    static bool waitUntil(Attempt attempt, Waiters& waiters, Waiters& opposite,
+                          const std::chrono::steady_clock::time_point* deadline) {
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (attempt()) {
+                wakeOne(opposite);
+                return true;
+            }
+            if (spin >= SPIN_BEFORE_YIELD) {
+                std::this_thread::yield();
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(waiters.mutex);
+        waiters.count.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool done;
+        if (deadline) {
+            done = waiters.condition.wait_until(lock, *deadline, attempt);
+        } else {
+            waiters.condition.wait(lock, attempt);
+            done = true;
+        }
+        waiters.count.fetch_sub(1, std::memory_order_relaxed);
+        lock.unlock();
+        if (done) {
+            wakeOne(opposite);
+        }
+        return done;
+    }
+
+    /**
+     * @brief Занимает ячейку и записывает элемент, не будя потребителей.
+     */
+    bool tryEnqueue(const T& item) {
+        std::size_t pos = enqueuePos.value.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Ячейку еще не освободил потребитель прошлого круга.
+            } else {
+                pos = enqueuePos.value.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = item;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Забирает элемент и освобождает ячейку, не будя производителей.
+     */
+    bool tryDequeue(T& item) {
+        std::size_t pos = dequeuePos.value.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0) {
+                if (dequeuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Производитель еще не заполнил ячейку.
+            } else {
+                pos = dequeuePos.value.load(std::memory_order_relaxed);
+            }
+        }
+        item = cell->value;
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+public:
+    /**
+     * @brief Создает очередь емкостью не меньше size элементов.
+     *
+     * @param size Требуемая емкость (округляется вверх до степени двойки).
+     */
+    explicit MpmcQueue(std::size_t size = 1024) : mask(roundCapacity(size) - 1) {
+        cells = new Cell[mask + 1];
+        for (std::size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue() {
+        delete[] cells;
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @brief Добавляет элемент, если есть место.
+     *
+     * @param item Элемент для добавления.
+     * @return false Если очередь полна.
+     */
+    bool try_enqueue(const T& item) {
+        if (!tryEnqueue(item)) {
+            return false;
+        }
+        wakeOne(notEmpty);
+        return true;
+    }
+
+    /**
+     * @brief Извлекает первый элемент, если он есть.
+     *
+     * @param item Сюда записывается извлеченный элемент.
+     * @return false Если очередь пуста.
+     */
+    bool try_dequeue(T& item) {
+        if (!tryDequeue(item)) {
+            return false;
+        }
+        wakeOne(notFull);
+        return true;
+    }
+
+    /**
+     * @brief Добавляет элемент, ожидая места сколько потребуется.
+     *
+     * @param item Элемент для добавления.
+     */
+    void push(const T& item) {
+        waitUntil([&]() { return tryEnqueue(item); }, notFull, notEmpty, nullptr);
+    }
+
+    /**
+     * @brief Добавляет элемент, ожидая места не дольше timeout.
+     *
+     * @param item Элемент для добавления.
+     * @param timeout Наибольшее время ожидания.
+     * @return false Если за timeout место не освободилось.
+     */
+    template <typename Rep, typename Period>
+    bool push(const T& item, const std::chrono::duration<Rep, Period>& timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        return waitUntil([&]() { return tryEnqueue(item); }, notFull, notEmpty, &deadline);
+    }
+
+    /**
+     * @brief Извлекает элемент, ожидая его сколько потребуется.
+     *
+     * @return T Извлеченный элемент.
+     */
+    T pop() {
+        T item;
+        waitUntil([&]() { return tryDequeue(item); }, notEmpty, notFull, nullptr);
+        return item;
+    }
+
+    /**
+     * @brief Извлекает элемент, ожидая его не дольше timeout.
+     *
+     * @param item Сюда записывается извлеченный элемент.
+     * @param timeout Наибольшее время ожидания.
+     * @return false Если за timeout элемент не появился.
+     */
+    template <typename Rep, typename Period>
+    bool pop(T& item, const std::chrono::duration<Rep, Period>& timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        return waitUntil([&]() { return tryDequeue(item); }, notEmpty, notFull, &deadline);
+    }
+
+    /**
+     * @brief Добавляет элемент в конец очереди.
+     *
+     * @param item Элемент для добавления.
+     * @throw std::overflow_error Если очередь полна.
+     */
+    void enqueue(const T& item) {
+        if (!try_enqueue(item)) {
+            throw std::overflow_error("Queue is full");
+        }
+    }
+
+    /**
+     * @brief Удаляет элемент из начала очереди.
+     *
+     * @throw std::out_of_range Если очередь пуста.
+     */
+    void dequeue() {
+        T item;
+        if (!try_dequeue(item)) {
+            throw std::out_of_range("Queue is empty");
+        }
+    }
+
+    /**
+     * @brief Получает первый элемент, не удаляя его.
+     *
+     * Корректен, только пока никто не извлекает элементы: иначе ячейку могут
+     * освободить и перезаписать во время чтения. Производители не мешают.
+     *
+     * @return T Первый элемент в очереди.
+     * @throw std::out_of_range Если очередь пуста.
+     */
+    T peek() const {
+        std::size_t pos = dequeuePos.value.load(std::memory_order_relaxed);
+        const Cell& cell = cells[pos & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            throw std::out_of_range("Queue is empty");
+        }
+        return cell.value;
+    }
+
+    /**
+     * @brief Проверяет, пуста ли очередь (при работающих потоках - на момент вызова).
+     */
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Получает текущий размер очереди (при работающих потоках - приблизительный).
+     *
+     * Учитывает и занятые, но еще не заполненные (не прочитанные) ячейки.
+     */
+    std::size_t size() const {
+        std::size_t head = dequeuePos.value.load(std::memory_order_acquire);
+        std::size_t tail = enqueuePos.value.load(std::memory_order_acquire);
+        std::size_t count = tail - head;
+        return count > mask + 1 ? mask + 1 : count;
+    }
+
+    /**
+     * @brief Получает емкость очереди.
+     */
+    std::size_t capacity() const {
+        return mask + 1;
+    }
+};
+
+/**
+ * @brief Замер пропускной способности MpmcQueue при многих потоках.
+ *
+ * Каждый производитель передает свою долю чисел через push, потребители
+ * забирают их через pop до получения стоп-значения (-1). Потом проверяется,
+ * что каждое число получено ровно один раз.
+ *
+ * @param operations Количество передаваемых элементов.
+ * @param producers Количество потоков-производителей.
+ * @param consumers Количество потоков-потребителей.
+ * @return double Миллионов элементов в секунду (0, если элементы потеряны или повторены).
+ */
+double benchmarkMpmc(long long operations, int producers, int consumers) {
+    MpmcQueue<long long> queue(1 << 14);
+    std::vector<std::atomic<unsigned char>> received(static_cast<std::size_t>(operations));
+    for (auto& flag : received) {
+        flag.store(0, std::memory_order_relaxed);
+    }
+    std::atomic<bool> unique{true};
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            for (long long item = queue.pop(); item >= 0; item = queue.pop()) {
+                if (received[static_cast<std::size_t>(item)].exchange(1, std::memory_order_relaxed)) {
+                    unique.store(false, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    std::vector<std::thread> producerThreads;
+    for (int p = 0; p < producers; ++p) {
+        producerThreads.emplace_back([&, p]() {
+            for (long long item = p; item < operations; item += producers) {
+                queue.push(item);
+            }
+        });
+    }
+    for (auto& thread : producerThreads) {
+        thread.join();
+    }
+    for (int c = 0; c < consumers; ++c) {
+        queue.push(-1);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bool complete = unique.load();
+    for (auto& flag : received) {
+        complete = complete && flag.load(std::memory_order_relaxed) == 1;
+    }
+    return complete ? operations / seconds / 1e6 : 0;
+}
+
 int main() {
     Queue<int> queue; // Создание экземпляра очереди.
     int choice, value; // Переменные для выбора и значения.
@@ -213,6 +864,8 @@ int main() {
         std::cout << "6. Получить размер очереди\n";
         std::cout << "7. Вывести очередь\n";
         std::cout << "8. Обойти очередь через итератор\n";
+        std::cout << "9. Тест производительности очереди SPSC (два потока)\n";
+        std::cout << "10. Тест производительности очереди MPMC (много потоков)\n";
         std::cout << "0. Выход\n";
         std::cout << "Выберите действие: ";
         std::cin >> choice; // Ввод выбора пользователя.
@@ -263,6 +916,23 @@ int main() {
                 }
                 std::cout << "\n";
                 break;
+            case 9: { // Тест производительности SPSC
+                const long long operations = 100000000;
+                std::cout << "Передача " << operations << " элементов между двумя потоками:\n";
+                std::cout << "  поэлементно: " << benchmarkSpsc(operations, 1) << " млн оп/с\n";
+                std::cout << "  пакетами по 64: " << benchmarkSpsc(operations, 64) << " млн оп/с\n";
+                break;
+            }
+            case 10: { // Тест производительности MPMC
+                const long long operations = 10000000;
+                const int threadCounts[] = {1, 4, 16, 32};
+                std::cout << "Передача " << operations << " элементов через push/pop:\n";
+                for (int threads : threadCounts) {
+                    std::cout << "  " << threads << " произв. x " << threads << " потреб.: "
+                              << benchmarkMpmc(operations, threads, threads) << " млн оп/с\n";
+                }
+                break;
+            }
             case 0: // Выход
                 std::cout << "Выход из программы.\n";
                 break;